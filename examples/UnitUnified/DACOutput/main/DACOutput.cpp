@@ -10,7 +10,7 @@
 #include <M5UnitUnified.h>
 #include <M5UnitUnifiedANADIG.h>
 #include <M5Utility.h>
-#include <cmath>
+#include <utility/waveform.hpp>
 
 // *************************************************************
 // Choose one define symbol to match the unit you are using
@@ -37,49 +37,17 @@ m5::unit::HatDAC2 unit;
 #else
 #error Please choose unit or hat!
 #endif
-uint32_t counter{};
+using m5::unit::anadig::Waveform;
+using m5::unit::anadig::WaveformGenerator;
 
-constexpr inline float deg2rad(const float deg)
-{
-    return ((deg) / 180.0f * M_PI);
-}
-
-float sin_curve(const uint32_t counter, const float maxMv)
-{
-    float rad = deg2rad(counter % 360);
-    float v   = sinf(rad);
-    return maxMv * (v + 1.0f) * 0.5f;
-}
-
-float sawtooth_wave(const uint32_t counter, const float maxMv)
-{
-    float rad = (counter % 360) / 360.f;
-    float v   = rad - floor(rad);
-    return v * maxMv;
-}
-
-float square_wave(const uint32_t counter, const float maxMv)
-{
-    float rad = deg2rad(counter % 360);
-    float v   = sinf(rad) / fabs(sinf(rad));
-    return maxMv * (v + 1.0f) * 0.5f;
-}
-
-float triangle_wave(const uint32_t counter, const float maxMv)
-{
-    float rad = deg2rad(counter % 360);
-    float v   = asinf(sinf(rad));
-    return maxMv * (v + M_PI / 2) / M_PI;
-}
-
-using function = float (*)(const uint32_t, const float);
-
-constexpr function func_table[4] = {
-    sin_curve,
-    sawtooth_wave,
-    triangle_wave,
-    square_wave,
+constexpr float frequency{2.0f};  // Hz
+constexpr uint8_t table_bits{8};  // 256 codes per period
 
+constexpr Waveform wave_table[4] = {
+    Waveform::Sine,
+    Waveform::Sawtooth,
+    Waveform::Triangle,
+    Waveform::Square,
 };
 const char* func_name_table[4] = {
     "SinCurve",
@@ -89,7 +57,32 @@ const char* func_name_table[4] = {
 };
 
 uint32_t fidx{};
-function func = func_table[fidx];
+WaveformGenerator gen0{}, gen1{};
+uint32_t start_us{};
+
+// The tables are computed only when the waveform or range is changed
+void build_tables()
+{
+#if defined(USING_UNIT_DAC)
+    const int32_t half0 = static_cast<int32_t>(m5::unit::UnitDAC::MAXIMUM_VOLTAGE * 1000.f) / 2;
+    gen0.build(wave_table[fidx], table_bits, [](const int32_t uv) { return unit.microvoltage_to_raw(uv); }, half0,
+               half0);
+    gen0.setFrequency(frequency, 0.0f);
+#else
+    const int32_t half0 = static_cast<int32_t>(unit.maximumVoltage(m5::unit::gp8413::Channel::Zero) * 1000.f) / 2;
+    const int32_t half1 = static_cast<int32_t>(unit.maximumVoltage(m5::unit::gp8413::Channel::One) * 1000.f) / 2;
+    // Through microvoltage_to_raw so that the correction is applied if set
+    gen0.build(
+        wave_table[fidx], table_bits,
+        [](const int32_t uv) { return unit.microvoltage_to_raw(m5::unit::gp8413::Channel::Zero, uv); }, half0, half0);
+    gen1.build(
+        wave_table[fidx], table_bits,
+        [](const int32_t uv) { return unit.microvoltage_to_raw(m5::unit::gp8413::Channel::One, uv); }, half1, half1);
+    gen0.setFrequency(frequency, 0.0f);
+    gen1.setFrequency(frequency, 0.0f);
+#endif
+    start_us = m5::utility::micros();
+}
 
 }  // namespace
 
@@ -127,6 +120,8 @@ void setup()
     unit.writeBothVoltage(0U, 0U);
 #endif
 
+    build_tables();
+
     M5_LOGI("M5UnitUnified has been begun");
     M5_LOGI("%s", Units.debugInfo().c_str());
 
@@ -155,18 +150,22 @@ void loop()
 
     Units.update();
 
+    // Only a table lookup and a bus write per update
+    const uint32_t elapsed = m5::utility::micros() - start_us;
 #if defined(USING_UNIT_DAC)
-    auto v0 = func(counter, max_0);
+    const uint16_t raw0 = gen0.at(elapsed);
+    unit.writeVoltage(raw0);
+    auto v0 = unit.raw_to_microvoltage(raw0) / 1000.f;
     auto v1 = 0.0f;
-    unit.writeVoltage(v0);
     M5.Log.printf("Voltage:%.2f\n", v0);
 #else
-    auto v0 = func(counter, max_0);
-    auto v1 = func(counter, max_1);
-    unit.writeBothVoltage(v0, v1);
+    const uint16_t raw0 = gen0.at(elapsed);
+    const uint16_t raw1 = gen1.at(elapsed);
+    unit.writeBothVoltage(raw0, raw1);
+    auto v0 = unit.raw_to_microvoltage(Channel::Zero, raw0) / 1000.f;
+    auto v1 = unit.raw_to_microvoltage(Channel::One, raw1) / 1000.f;
     M5.Log.printf("Voltage:%.2f / %.2f\n", v0, v1);
 #endif
-    counter += 6;
 
     auto bwid = lcd.width() >> 3;
 
@@ -197,9 +196,8 @@ void loop()
 
     // Change output function
     if (M5.BtnA.wasClicked() || touch.wasClicked()) {
-        fidx    = (fidx + 1) % m5::stl::size(func_table);
-        func    = func_table[fidx];
-        counter = 0;
+        fidx = (fidx + 1) % m5::stl::size(wave_table);
+        build_tables();
 
         M5.Speaker.tone(2000, 20);
         lcd.fillScreen(TFT_BLACK);
@@ -220,6 +218,7 @@ void loop()
                               (range_mode & 0x02) ? Output::Range10V : Output::Range5V);
         max_0 = unit.maximumVoltage(Channel::Zero);
         max_1 = unit.maximumVoltage(Channel::One);
+        build_tables();
 
         M5.Log.printf("---- Range V0:%uV V1:%uV\n", (int)(max_0 / 1000), (int)(max_1 / 1000));
     }
@@ -17,6 +17,9 @@
 #include "unit/unit_ADS1110.hpp"
 #include "unit/unit_MCP4725.hpp"
 #include "unit/unit_GP8413.hpp"
+#include "unit/dac_group.hpp"
+#include "unit/control_loop.hpp"
+#include "unit/loopback_sweep.hpp"
 
 /*!
   @namespace m5
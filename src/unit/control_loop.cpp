@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file control_loop.cpp
+  @brief Closed-loop control from an ADC input to a DAC output
+*/
+#include "control_loop.hpp"
+#include <M5Utility.hpp>
+
+namespace m5 {
+namespace unit {
+
+bool ControlLoop::begin(UnitADS11XX& adc, UnitGP8413& dac, const gp8413::Channel channel, const anadig::PidConfig& cfg)
+{
+    end();
+    _gp8413  = &dac;
+    _channel = channel;
+    return begin(adc, cfg, dac.scale(channel).clamp_uv, dac.raw_to_microvoltage(channel, dac.lastValue(channel)));
+}
+
+bool ControlLoop::begin(UnitADS11XX& adc, UnitMCP4725& dac, const anadig::PidConfig& cfg)
+{
+    end();
+    _mcp4725 = &dac;
+    return begin(adc, cfg, dac.scale().clamp_uv, dac.raw_to_microvoltage(dac.lastValue()));
+}
+
+bool ControlLoop::begin(UnitADS11XX& adc, const anadig::PidConfig& cfg, const uint32_t full_uv,
+                        const int32_t initial_uv)
+{
+    if (!adc.inPeriodic()) {
+        M5_LIB_LOGE("The ADC is not in periodic measurement");
+        _gp8413  = nullptr;
+        _mcp4725 = nullptr;
+        return false;
+    }
+
+    // Keep the output limits within the DAC range
+    anadig::PidConfig c = cfg;
+    const int32_t full  = static_cast<int32_t>(full_uv);
+    c.out_min           = (c.out_min > 0) ? c.out_min : 0;
+    c.out_max           = (c.out_max > 0 && c.out_max < full) ? c.out_max : full;
+    if (c.out_min > c.out_max) {
+        c.out_min = c.out_max;
+    }
+    _pid.config(c);
+    _pid.reset(initial_uv);  // Bumpless
+    resetStatistics();
+
+    _adc = &adc;
+    _adc->setSampleCallback([this](UnitADS11XX&, const ads11xx::Data& data, const uint32_t arrived_us) {
+        on_sample(data, arrived_us);
+    });
+    return true;
+}
+
+void ControlLoop::end()
+{
+    if (_adc) {
+        _adc->setSampleCallback(nullptr);
+    }
+    _adc     = nullptr;
+    _gp8413  = nullptr;
+    _mcp4725 = nullptr;
+}
+
+void ControlLoop::resetStatistics()
+{
+    _samples = _failed = _latency = _max_latency = _min_latency = 0;
+    _sum_latency = 0;
+}
+
+void ControlLoop::on_sample(const ads11xx::Data& data, const uint32_t arrived_us)
+{
+    _measurement = data.differentialMicroVoltage();
+    // The output is not applied if the write fails, so the integrator must not advance
+    const anadig::Pid prev = _pid;
+    if (!write(_pid.step(_setpoint, _measurement))) {
+        _pid = prev;
+        ++_failed;
+        return;
+    }
+    _latency     = m5::utility::micros() - arrived_us;
+    _min_latency = (!_samples || _latency < _min_latency) ? _latency : _min_latency;
+    _max_latency = (_latency > _max_latency) ? _latency : _max_latency;
+    _sum_latency += _latency;
+    ++_samples;
+}
+
+bool ControlLoop::write(const int32_t uv)
+{
+    return _gp8413 ? _gp8413->writeVoltage(_channel, _gp8413->microvoltage_to_raw(_channel, uv))
+                   : _mcp4725->writeVoltage(_mcp4725->microvoltage_to_raw(uv));
+}
+
+}  // namespace unit
+}  // namespace m5
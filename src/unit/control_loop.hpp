@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file control_loop.hpp
+  @brief Closed-loop control from an ADC input to a DAC output
+*/
+#ifndef M5_UNIT_ANADIG_UNIT_CONTROL_LOOP_HPP
+#define M5_UNIT_ANADIG_UNIT_CONTROL_LOOP_HPP
+
+#include "unit_ADS11xx.hpp"
+#include "unit_GP8413.hpp"
+#include "unit_MCP4725.hpp"
+#include "../utility/pid.hpp"
+
+namespace m5 {
+namespace unit {
+
+/*!
+  @class ControlLoop
+  @brief Runs the PID for each new ADC sample and writes the DAC in the same update()
+  @details Subscribes to the samples of the ADC (UnitADS11XX::setSampleCallback).
+  The measurement and the output are in uV, and the output limits are kept within the DAC range.
+  The latency from the sample arrival to the completion of the DAC write is measured
+  @code
+  m5::unit::anadig::PidConfig cfg{};
+  cfg.kp_q16 = m5::unit::anadig::Pid::gain(0.8f);
+  cfg.ki_q16 = m5::unit::anadig::Pid::gain(0.1f);
+  ControlLoop loop;
+  loop.begin(adc, gp8413, gp8413::Channel::Zero, cfg);
+  loop.setSetpoint(500 * 1000);  // 500mV
+  // In loop()
+  Units.update();  // The PID runs in the update of the ADC
+  @endcode
+  @warning The ADC must be in periodic measurement. The sample callback of the ADC is occupied until end()
+ */
+class ControlLoop {
+public:
+    ControlLoop() = default;
+    ControlLoop(const ControlLoop&)            = delete;
+    ControlLoop& operator=(const ControlLoop&) = delete;
+    ~ControlLoop()
+    {
+        end();
+    }
+
+    /*!
+      @brief Start the loop to the channel of the GP8413
+      @param adc Input
+      @param dac Output
+      @param channel Output channel
+      @param cfg PID settings (Output in uV, zero out_max means the maximum of the current range)
+      @return True if successful
+     */
+    bool begin(UnitADS11XX& adc, UnitGP8413& dac, const gp8413::Channel channel, const anadig::PidConfig& cfg);
+    /*!
+      @brief Start the loop to the MCP4725
+      @param adc Input
+      @param dac Output
+      @param cfg PID settings (Output in uV, zero out_max means the maximum of the DAC)
+      @return True if successful
+     */
+    bool begin(UnitADS11XX& adc, UnitMCP4725& dac, const anadig::PidConfig& cfg);
+    //! @brief Stop the loop and unsubscribe
+    void end();
+
+    ///@name Properties
+    ///@{
+    //! @brief Is running?
+    inline bool running() const
+    {
+        return _adc != nullptr;
+    }
+    //! @brief Gets the setpoint(uV)
+    inline int32_t setpoint() const
+    {
+        return _setpoint;
+    }
+    //! @brief Set the setpoint(uV)
+    inline void setSetpoint(const int32_t uv)
+    {
+        _setpoint = uv;
+    }
+    //! @brief Gets the PID
+    inline const anadig::Pid& pid() const
+    {
+        return _pid;
+    }
+    //! @brief Gets the last measurement(uV)
+    inline int32_t measurement() const
+    {
+        return _measurement;
+    }
+    ///@}
+
+    ///@name Statistics
+    ///@{
+    //! @brief Number of processed samples
+    inline uint32_t samples() const
+    {
+        return _samples;
+    }
+    //! @brief Number of failed DAC writes (The controller state is rolled back for them)
+    inline uint32_t failed() const
+    {
+        return _failed;
+    }
+    //! @brief Latency(us) of the last sample
+    inline uint32_t latency() const
+    {
+        return _latency;
+    }
+    //! @brief Maximum latency(us)
+    inline uint32_t maxLatency() const
+    {
+        return _max_latency;
+    }
+    //! @brief Minimum latency(us)
+    inline uint32_t minLatency() const
+    {
+        return _samples ? _min_latency : 0;
+    }
+    //! @brief Mean latency(us)
+    inline uint32_t meanLatency() const
+    {
+        return _samples ? static_cast<uint32_t>(_sum_latency / _samples) : 0;
+    }
+    //! @brief Clear the statistics
+    void resetStatistics();
+    ///@}
+
+private:
+    bool begin(UnitADS11XX& adc, const anadig::PidConfig& cfg, const uint32_t full_uv, const int32_t initial_uv);
+    void on_sample(const ads11xx::Data& data, const uint32_t arrived_us);
+    bool write(const int32_t uv);
+
+    UnitADS11XX* _adc{};
+    UnitGP8413* _gp8413{};
+    UnitMCP4725* _mcp4725{};
+    gp8413::Channel _channel{};
+    anadig::Pid _pid{};
+    int32_t _setpoint{}, _measurement{};
+    uint32_t _samples{}, _failed{}, _latency{}, _max_latency{}, _min_latency{};
+    uint64_t _sum_latency{};
+};
+
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,186 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file dac_group.cpp
+  @brief Synchronized update of multiple DAC outputs
+*/
+#include "dac_group.hpp"
+#include <M5Utility.hpp>
+
+using namespace m5::unit::gp8413;
+using namespace m5::unit::gp8413::command;
+
+namespace m5 {
+namespace unit {
+
+constexpr uint8_t DACGroup::MAX_MEMBERS;
+constexpr uint8_t DACGroup::MAX_TRANSACTIONS;
+
+int8_t DACGroup::add(UnitGP8413& unit, const gp8413::Channel channel)
+{
+    const uint8_t ch  = m5::stl::to_underlying(channel);
+    const uint8_t bit = 1U << ch;
+    uint8_t i{};
+    while (i < _num_transactions && _trans[i].gp8413 != &unit) {
+        ++i;
+    }
+    if (i < _num_transactions && (_trans[i].mask & bit)) {
+        M5_LIB_LOGW("Already added");
+        return -1;
+    }
+    if (_num_members >= MAX_MEMBERS || i >= MAX_TRANSACTIONS) {
+        M5_LIB_LOGE("Too many members");
+        return -1;
+    }
+    if (i == _num_transactions) {
+        _trans[i]        = Transaction{};
+        _trans[i].gp8413 = &unit;
+        _trans[i].raw[0] = unit.lastValue(Channel::Zero);
+        _trans[i].raw[1] = unit.lastValue(Channel::One);
+        ++_num_transactions;
+    }
+    _trans[i].mask |= bit;
+    build(_trans[i]);
+    return add_member(i, ch);
+}
+
+int8_t DACGroup::add(UnitMCP4725& unit)
+{
+    for (uint8_t i = 0; i < _num_transactions; ++i) {
+        if (_trans[i].mcp4725 == &unit) {
+            M5_LIB_LOGW("Already added");
+            return -1;
+        }
+    }
+    if (_num_members >= MAX_MEMBERS || _num_transactions >= MAX_TRANSACTIONS) {
+        M5_LIB_LOGE("Too many members");
+        return -1;
+    }
+    const uint8_t i   = _num_transactions++;
+    _trans[i]         = Transaction{};
+    _trans[i].mcp4725 = &unit;
+    _trans[i].raw[0]  = unit.lastValue();
+    build(_trans[i]);
+    return add_member(i, 0);
+}
+
+void DACGroup::clear()
+{
+    _num_members = _num_transactions = 0;
+}
+
+int8_t DACGroup::add_member(const uint8_t trans, const uint8_t channel)
+{
+    _members[_num_members].trans   = trans;
+    _members[_num_members].channel = channel;
+    return static_cast<int8_t>(_num_members++);
+}
+
+bool DACGroup::set(const int8_t idx, const uint16_t raw)
+{
+    if (idx < 0 || idx >= _num_members) {
+        return false;
+    }
+    const Member& m = _members[idx];
+    Transaction& t  = _trans[m.trans];
+    t.raw[m.channel] = raw & (t.mcp4725 ? UnitMCP4725::RESOLUTION : UnitGP8413::RESOLUTION);
+    build(t);
+    return true;
+}
+
+bool DACGroup::setMicroVoltage(const int8_t idx, const int32_t uv)
+{
+    if (idx < 0 || idx >= _num_members || uv < 0) {
+        return false;
+    }
+    const Member& m      = _members[idx];
+    const Transaction& t = _trans[m.trans];
+    return set(idx, t.mcp4725 ? t.mcp4725->microvoltage_to_raw(uv)
+                              : t.gp8413->microvoltage_to_raw(static_cast<Channel>(m.channel), uv));
+}
+
+bool DACGroup::commit()
+{
+    if (!_num_transactions) {
+        return false;
+    }
+
+    uint32_t end_at[MAX_TRANSACTIONS]{};
+    bool ok[MAX_TRANSACTIONS]{};
+    const uint32_t start_at = m5::utility::micros();
+    for (uint_fast8_t i = 0; i < _num_transactions; ++i) {
+        ok[i]     = write(_trans[i]);
+        end_at[i] = m5::utility::micros();
+    }
+
+    // Bookkeeping after all transactions
+    bool result{true};
+    for (uint_fast8_t i = 0; i < _num_transactions; ++i) {
+        Transaction& t = _trans[i];
+        if (!ok[i]) {
+            ++_failed;
+            result = false;
+            continue;
+        }
+        if (t.mcp4725) {
+            if (!t.mcp4725->eepromBusy()) {
+                t.mcp4725->written(t.raw[0]);
+            }
+        } else if (!t.gp8413->storeBusy()) {
+            for (uint_fast8_t ch = 0; ch < 2; ++ch) {
+                if (t.mask & (1U << ch)) {
+                    t.gp8413->written(static_cast<Channel>(ch), t.raw[ch]);
+                }
+            }
+        }
+    }
+    _duration = end_at[_num_transactions - 1] - start_at;
+    _skew     = end_at[_num_transactions - 1] - end_at[0];
+    _max_skew = (_skew > _max_skew) ? _skew : _max_skew;
+    ++_commits;
+    return result;
+}
+
+void DACGroup::build(Transaction& t)
+{
+    if (t.mcp4725) {
+        t.pd  = t.mcp4725->powerDown();
+        t.len = static_cast<uint8_t>(t.mcp4725->make_buffer(t.buf, t.raw[0], UnitMCP4725::Command::FastMode));
+        return;
+    }
+    // Channel 0 first, both channels are contiguous
+    uint8_t* p = t.buf;
+    for (uint_fast8_t ch = 0; ch < 2; ++ch) {
+        if (t.mask & (1U << ch)) {
+            *p++ = t.raw[ch] & 0xFF;
+            *p++ = t.raw[ch] >> 8;
+        }
+    }
+    t.len = static_cast<uint8_t>(p - t.buf);
+    t.reg = (t.mask & 0x01) ? OUTPUT_CHANNEL0_REG : OUTPUT_CHANNEL1_REG;
+}
+
+bool DACGroup::write(Transaction& t)
+{
+    if (t.mcp4725) {
+        if (t.mcp4725->eepromBusy()) {
+            return t.mcp4725->writeVoltage(t.raw[0]);  // Deferred
+        }
+        if (t.pd != t.mcp4725->powerDown()) {
+            build(t);
+        }
+        return t.mcp4725->writeWithTransaction(t.buf, t.len) == m5::hal::error::error_t::OK;
+    }
+    if (t.gp8413->storeBusy()) {
+        // Deferred
+        return (t.mask == 0x03) ? t.gp8413->writeBothVoltage(t.raw[0], t.raw[1])
+                                : t.gp8413->writeVoltage(static_cast<Channel>(t.mask >> 1), t.raw[t.mask >> 1]);
+    }
+    return t.gp8413->write_voltage(t.reg, t.buf, t.len);
+}
+
+}  // namespace unit
+}  // namespace m5
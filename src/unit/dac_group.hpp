@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file dac_group.hpp
+  @brief Synchronized update of multiple DAC outputs
+*/
+#ifndef M5_UNIT_ANADIG_UNIT_DAC_GROUP_HPP
+#define M5_UNIT_ANADIG_UNIT_DAC_GROUP_HPP
+
+#include "unit_GP8413.hpp"
+#include "unit_MCP4725.hpp"
+
+namespace m5 {
+namespace unit {
+
+/*!
+  @class DACGroup
+  @brief Updates the outputs of several DAC units with minimal skew
+  @details The I2C frames are built when the codes are set, and commit() only issues the transactions
+  back-to-back. The frame of MCP4725 is rebuilt on commit only if its power-down mode has been changed
+  (The output range of GP8413 is not a part of the frame).
+  Both channels of a GP8413 in the group are written in a single transaction.
+  The skew (time between the end of the first and the last transaction) is measured on each commit
+  @code
+  DACGroup group;
+  auto x = group.add(gp8413_a, gp8413::Channel::Zero);
+  auto y = group.add(gp8413_a, gp8413::Channel::One);
+  auto z = group.add(mcp4725);
+  // Stage and commit
+  group.set(x, 0x1000);
+  group.set(y, 0x2000);
+  group.setMicroVoltage(z, 1650 * 1000);
+  group.commit();
+  @endcode
+  @warning The units must be on the same bus for the transactions to be back-to-back
+  @note If the non-volatile memory of a unit is busy, its output is deferred as usual
+ */
+class DACGroup {
+public:
+    static constexpr uint8_t MAX_MEMBERS{24};       //!< Maximum number of outputs (8 GP8413 and 8 MCP4725)
+    static constexpr uint8_t MAX_TRANSACTIONS{16};  //!< Maximum number of units
+
+    DACGroup() = default;
+
+    ///@name Members
+    ///@{
+    /*!
+      @brief Add the channel of the GP8413
+      @param unit Unit
+      @param channel Channel
+      @return Index of the member, or negative if failed
+     */
+    int8_t add(UnitGP8413& unit, const gp8413::Channel channel);
+    /*!
+      @brief Add the MCP4725
+      @param unit Unit
+      @return Index of the member, or negative if failed
+     */
+    int8_t add(UnitMCP4725& unit);
+    //! @brief Remove all members
+    void clear();
+    //! @brief Number of members
+    inline uint8_t members() const
+    {
+        return _num_members;
+    }
+    //! @brief Number of transactions on commit
+    inline uint8_t transactions() const
+    {
+        return _num_transactions;
+    }
+    ///@}
+
+    ///@name Stage
+    ///@{
+    /*!
+      @brief Stage the code of the member
+      @param idx Index of the member
+      @param raw Output voltage raw value
+      @return True if successful
+     */
+    bool set(const int8_t idx, const uint16_t raw);
+    /*!
+      @brief Stage the voltage of the member without floating point operations
+      @param idx Index of the member
+      @param uv Output voltage(uV)
+      @return True if successful
+     */
+    bool setMicroVoltage(const int8_t idx, const int32_t uv);
+    ///@}
+
+    /*!
+      @brief Issue the staged outputs of all members
+      @return True if all transactions are successful
+     */
+    bool commit();
+
+    ///@name Statistics
+    ///@{
+    //! @brief Skew(us) of the last commit
+    inline uint32_t skew() const
+    {
+        return _skew;
+    }
+    //! @brief Maximum skew(us)
+    inline uint32_t maxSkew() const
+    {
+        return _max_skew;
+    }
+    //! @brief Duration(us) of the last commit
+    inline uint32_t duration() const
+    {
+        return _duration;
+    }
+    //! @brief Number of commits
+    inline uint32_t commits() const
+    {
+        return _commits;
+    }
+    //! @brief Number of failed transactions
+    inline uint32_t failed() const
+    {
+        return _failed;
+    }
+    //! @brief Clear the statistics
+    inline void resetStatistics()
+    {
+        _skew = _max_skew = _duration = _commits = _failed = 0;
+    }
+    ///@}
+
+private:
+    struct Transaction {
+        UnitGP8413* gp8413{};
+        UnitMCP4725* mcp4725{};
+        uint8_t mask{};  // Channels of GP8413
+        uint16_t raw[2]{};
+        uint8_t buf[4]{};         // Frame
+        uint8_t len{};            // Size of the frame
+        uint8_t reg{};            // Register of GP8413
+        mcp4725::PowerDown pd{};  // Power-down mode of MCP4725 in the frame
+    };
+    struct Member {
+        uint8_t trans{};
+        uint8_t channel{};
+    };
+
+    int8_t add_member(const uint8_t trans, const uint8_t channel);
+    void build(Transaction& t);
+    bool write(Transaction& t);
+
+    Transaction _trans[MAX_TRANSACTIONS]{};
+    Member _members[MAX_MEMBERS]{};
+    uint8_t _num_members{}, _num_transactions{};
+    uint32_t _skew{}, _max_skew{}, _duration{}, _commits{}, _failed{};
+};
+
+}  // namespace unit
+}  // namespace m5
+#endif
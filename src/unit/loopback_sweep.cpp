@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file loopback_sweep.cpp
+  @brief DAC-to-ADC loopback sweep for linearity characterization
+*/
+#include "loopback_sweep.hpp"
+#include <M5Utility.hpp>
+
+namespace m5 {
+namespace unit {
+
+bool LoopbackSweep::begin(UnitADS11XX& adc, UnitGP8413& dac, const gp8413::Channel channel, const SweepConfig& cfg)
+{
+    abort();
+    _gp8413  = &dac;
+    _mcp4725 = nullptr;
+    _channel = channel;
+    return begin(adc, cfg, dac.scale(channel));
+}
+
+bool LoopbackSweep::begin(UnitADS11XX& adc, UnitMCP4725& dac, const SweepConfig& cfg)
+{
+    abort();
+    _gp8413  = nullptr;
+    _mcp4725 = &dac;
+    return begin(adc, cfg, dac.scale());
+}
+
+bool LoopbackSweep::begin(UnitADS11XX& adc, const SweepConfig& cfg, const anadig::CodeScale& nominal)
+{
+    _adc      = nullptr;
+    _nominal  = nominal;
+    _cfg      = cfg;
+    _cfg.last = _cfg.last ? _cfg.last : static_cast<uint16_t>(nominal.max_code);
+    if (_cfg.points < 2 || _cfg.points > anadig::DacCorrection::MAX_POINTS || !_cfg.average ||
+        _cfg.first >= _cfg.last || _cfg.last > nominal.max_code ||
+        (uint32_t)(_cfg.last - _cfg.first) < (uint32_t)(_cfg.points - 1)) {
+        M5_LIB_LOGE("Invalid settings");
+        return false;
+    }
+    _adc   = &adc;
+    _state = State::Idle;
+    return true;
+}
+
+bool LoopbackSweep::start()
+{
+    if (!_adc || running()) {
+        return false;
+    }
+    if (!_adc->inPeriodic()) {
+        M5_LIB_LOGE("The ADC is not in periodic measurement");
+        return false;
+    }
+    _step       = 0;
+    _started_at = m5::utility::millis();
+    _state      = State::Running;
+    _adc->setSampleCallback([this](UnitADS11XX&, const ads11xx::Data& data, const uint32_t arrived_us) {
+        on_sample(data, arrived_us);
+    });
+    if (!next_point()) {
+        finish(State::Failed);
+        return false;
+    }
+    return true;
+}
+
+void LoopbackSweep::abort()
+{
+    if (running()) {
+        finish(State::Idle);
+    }
+}
+
+uint16_t LoopbackSweep::code_of(const uint8_t step) const
+{
+    return _cfg.first + static_cast<uint16_t>((static_cast<uint32_t>(_cfg.last - _cfg.first) * step +
+                                               (_cfg.points - 1) / 2) /
+                                              (_cfg.points - 1));
+}
+
+// Write the code of the current step and wait for the settled conversion
+bool LoopbackSweep::next_point()
+{
+    if (!write(code_of(_step))) {
+        return false;
+    }
+    // A sample read at the time was converted within the last 2 intervals
+    _discard_until = m5::utility::micros() + _cfg.settle_us + _adc->interval() * 1000U * 2;
+    _count         = 0;
+    _sum           = 0;
+    return true;
+}
+
+void LoopbackSweep::on_sample(const ads11xx::Data& data, const uint32_t arrived_us)
+{
+    if (!running() || (int32_t)(arrived_us - _discard_until) < 0) {
+        return;
+    }
+    _sum += data.differentialMicroVoltage();
+    if (++_count < _cfg.average) {
+        return;
+    }
+
+    const int64_t half  = (_sum < 0) ? -(_cfg.average / 2) : (_cfg.average / 2);
+    _points[_step].code = code_of(_step);
+    _points[_step].uv   = static_cast<int32_t>((_sum + half) / _cfg.average);
+    if (++_step >= _cfg.points) {
+        const bool ok = anadig::analyze_linearity(_points, _step, _result, _inl, _step_error);
+        finish(ok ? State::Done : State::Failed);
+        return;
+    }
+    if (!next_point()) {
+        finish(State::Failed);
+    }
+}
+
+bool LoopbackSweep::write(const uint16_t code)
+{
+    return _gp8413 ? _gp8413->writeVoltage(_channel, code) : _mcp4725->writeVoltage(code);
+}
+
+void LoopbackSweep::finish(const State s)
+{
+    _adc->setSampleCallback(nullptr);
+    _elapsed_ms = m5::utility::millis() - _started_at;
+    _state      = s;
+}
+
+bool LoopbackSweep::buildDacCorrection(anadig::DacCorrection& correction) const
+{
+    return _state == State::Done && correction.build(_points, _step, static_cast<uint16_t>(_nominal.max_code));
+}
+
+bool LoopbackSweep::adcCorrection(anadig::GainOffset& correction) const
+{
+    return _state == State::Done && anadig::adc_correction(_points, _step, _nominal, correction);
+}
+
+}  // namespace unit
+}  // namespace m5
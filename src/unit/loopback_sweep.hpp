@@ -0,0 +1,190 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file loopback_sweep.hpp
+  @brief DAC-to-ADC loopback sweep for linearity characterization
+*/
+#ifndef M5_UNIT_ANADIG_UNIT_LOOPBACK_SWEEP_HPP
+#define M5_UNIT_ANADIG_UNIT_LOOPBACK_SWEEP_HPP
+
+#include "unit_ADS11xx.hpp"
+#include "unit_GP8413.hpp"
+#include "unit_MCP4725.hpp"
+#include "../utility/linearity.hpp"
+
+namespace m5 {
+namespace unit {
+
+/*!
+  @struct SweepConfig
+  @brief Sweep settings
+ */
+struct SweepConfig {
+    uint16_t first{};          //!< First code
+    uint16_t last{};           //!< Last code (0: Maximum code of the DAC)
+    uint8_t points{33};        //!< Number of points (2 - anadig::DacCorrection::MAX_POINTS)
+    uint8_t average{8};        //!< Number of samples averaged at each point
+    uint32_t settle_us{1000};  //!< Settling time(us) of the DAC output and the input
+};
+
+/*!
+  @class LoopbackSweep
+  @brief Steps the DAC through the codes and measures the output with the ADC
+  @details Runs in the sample callback of the ADC (UnitADS11XX::setSampleCallback), so the sweep advances
+  as fast as the sampling rate allows while the application calls update() of the units.
+  After each DAC write, samples are discarded until a conversion that started after the settling time
+  (settle_us + 2 sampling intervals), then the average of the samples is recorded
+  @code
+  LoopbackSweep sweep;
+  sweep.begin(adc, dac, cfg);
+  sweep.start();
+  while (sweep.running()) {
+      Units.update();
+  }
+  anadig::DacCorrection corr;
+  if (sweep.buildDacCorrection(corr)) {
+      dac.setCorrection(&corr);  // ADC as the reference
+  }
+  @endcode
+  @note The characterization is relative. The DAC correction takes the ADC as the reference, and the ADC
+  correction takes the nominal DAC as the reference. Apply the one for the less trusted device
+  @note The ADC must be in periodic measurement. The sample callback of the ADC is occupied while running
+ */
+class LoopbackSweep {
+public:
+    //! @brief State
+    enum class State : uint8_t {
+        Idle,     //!< Not started
+        Running,  //!< Sweeping
+        Done,     //!< Completed and analyzed
+        Failed,   //!< Failed to write the DAC or to analyze
+    };
+
+    LoopbackSweep() = default;
+    LoopbackSweep(const LoopbackSweep&)            = delete;
+    LoopbackSweep& operator=(const LoopbackSweep&) = delete;
+    ~LoopbackSweep()
+    {
+        abort();
+    }
+
+    /*!
+      @brief Set up the sweep to the channel of the GP8413
+      @param adc Input
+      @param dac Output
+      @param channel Output channel
+      @param cfg Settings
+      @return True if successful
+     */
+    bool begin(UnitADS11XX& adc, UnitGP8413& dac, const gp8413::Channel channel, const SweepConfig& cfg);
+    /*!
+      @brief Set up the sweep to the MCP4725
+      @param adc Input
+      @param dac Output
+      @param cfg Settings
+      @return True if successful
+     */
+    bool begin(UnitADS11XX& adc, UnitMCP4725& dac, const SweepConfig& cfg);
+
+    /*!
+      @brief Start the sweep
+      @return True if successful
+     */
+    bool start();
+    //! @brief Abort the sweep
+    void abort();
+
+    ///@name Properties
+    ///@{
+    //! @brief Gets the state
+    inline State state() const
+    {
+        return _state;
+    }
+    //! @brief Is running?
+    inline bool running() const
+    {
+        return _state == State::Running;
+    }
+    //! @brief Number of measured points
+    inline uint8_t size() const
+    {
+        return _step;
+    }
+    //! @brief Gets the measured points
+    inline const anadig::LinearityPoint* points() const
+    {
+        return _points;
+    }
+    //! @brief Gets the result of the analysis (Valid if Done)
+    inline const anadig::LinearityResult& result() const
+    {
+        return _result;
+    }
+    //! @brief Gets the INL of each point (LSB, Valid if Done)
+    inline const float* inl() const
+    {
+        return _inl;
+    }
+    /*!
+      @brief Gets the step error of each step (LSB per code, Valid if Done)
+      @note The DNL if the points are on consecutive codes (points == last - first + 1)
+     */
+    inline const float* stepError() const
+    {
+        return _step_error;
+    }
+    //! @brief Time(ms) taken by the sweep
+    inline uint32_t elapsed() const
+    {
+        return _elapsed_ms;
+    }
+    ///@}
+
+    ///@name Correction tables
+    ///@{
+    /*!
+      @brief Build the DAC correction using the ADC as the reference
+      @param[out] correction Correction for UnitGP8413/UnitMCP4725::setCorrection
+      @return True if successful
+     */
+    bool buildDacCorrection(anadig::DacCorrection& correction) const;
+    /*!
+      @brief Calculate the ADC correction using the nominal DAC as the reference
+      @param[out] correction Correction for UnitADS11XX::setCorrection with the PGA used in the sweep
+      @note The ADC must be swept without the correction of the PGA
+      @return True if successful
+     */
+    bool adcCorrection(anadig::GainOffset& correction) const;
+    ///@}
+
+private:
+    bool begin(UnitADS11XX& adc, const SweepConfig& cfg, const anadig::CodeScale& nominal);
+    void on_sample(const ads11xx::Data& data, const uint32_t arrived_us);
+    bool next_point();
+    uint16_t code_of(const uint8_t step) const;
+    bool write(const uint16_t code);
+    void finish(const State s);
+
+    UnitADS11XX* _adc{};
+    UnitGP8413* _gp8413{};
+    UnitMCP4725* _mcp4725{};
+    gp8413::Channel _channel{};
+    SweepConfig _cfg{};
+    anadig::CodeScale _nominal{};
+
+    State _state{State::Idle};
+    uint8_t _step{}, _count{};
+    int64_t _sum{};
+    uint32_t _discard_until{}, _started_at{}, _elapsed_ms{};
+    anadig::LinearityPoint _points[anadig::DacCorrection::MAX_POINTS]{};
+    float _inl[anadig::DacCorrection::MAX_POINTS]{}, _step_error[anadig::DacCorrection::MAX_POINTS]{};
+    anadig::LinearityResult _result{};
+};
+
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -21,6 +21,7 @@ constexpr uint32_t interval_table[] = {
     1000 / 16 + 1,
     1000 / 8,
 };
+constexpr float sampling_rate_table[] = {128.f, 32.f, 16.f, 8.f};
 
 }  // namespace
 
@@ -93,6 +94,11 @@ uint32_t UnitADS1100::get_interval(const uint8_t rate)
     return interval_table[rate & 0x03];
 }
 
+float UnitADS1100::get_sampling_rate(const uint8_t rate)
+{
+    return sampling_rate_table[rate & 0x03];
+}
+
 bool UnitADS1100::read_if_ready_in_periodic(uint8_t v[2])
 {
     // ADS1100 don't have data ready status for periodic
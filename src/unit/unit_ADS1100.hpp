@@ -163,6 +163,7 @@ protected:
     bool start_periodic_measurement(const ads1100::Sampling rate, const ads1100::PGA pga);
     virtual bool read_if_ready_in_periodic(uint8_t v[2]) override;
     virtual uint32_t get_interval(const uint8_t rate) override;
+    virtual float get_sampling_rate(const uint8_t rate) override;
 
 private:
     config_t _cfg{};
@@ -15,13 +15,7 @@ using namespace m5::unit::types;
 using namespace m5::unit::ads1110;
 
 namespace {
-constexpr uint32_t interval_table[] = {
-    1000 / 250,
-    1000 / 60 + 1,
-    1000 / 30 + 1,
-    1000 / 15 + 1,
-};
-
+constexpr float sampling_rate_table[] = {240.f, 60.f, 30.f, 15.f};
 }  // namespace
 
 namespace m5 {
@@ -89,7 +83,12 @@ bool UnitADS1110::writeSamplingRate(const ads1110::Sampling rate)
 
 uint32_t UnitADS1110::get_interval(const uint8_t rate)
 {
-    return interval_table[rate & 0x03];
+    return ads1110::interval(static_cast<Sampling>(rate & 0x03));
+}
+
+float UnitADS1110::get_sampling_rate(const uint8_t rate)
+{
+    return sampling_rate_table[rate & 0x03];
 }
 
 }  // namespace unit
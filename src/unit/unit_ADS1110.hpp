@@ -32,6 +32,15 @@ enum class Sampling : uint8_t {
 using PGA  = m5::unit::ads11xx::PGA;
 using Data = m5::unit::ads11xx::Data;
 
+//! @brief Gets the periodic measurement interval(ms) for the sampling rate
+constexpr uint32_t interval(const Sampling rate)
+{
+    return (rate == Sampling::Rate240)  ? 1000 / 250
+           : (rate == Sampling::Rate60) ? 1000 / 60 + 1
+           : (rate == Sampling::Rate30) ? 1000 / 30 + 1
+                                        : 1000 / 15 + 1;
+}
+
 }  // namespace ads1110
 
 /*!
@@ -158,11 +167,159 @@ public:
 protected:
     bool start_periodic_measurement(const ads1110::Sampling rate, const ads1110::PGA pga);
     virtual uint32_t get_interval(const uint8_t rate) override;
+    virtual float get_sampling_rate(const uint8_t rate) override;
 
 private:
     config_t _cfg{};
 };
 
+/*!
+  @class UnitADS1110Fixed
+  @brief ADS1110 with sampling rate, PGA and correction factor fixed at compile time
+  @tparam Rate Data sampling rate
+  @tparam Gain Programmable Gain Amplifier
+  @tparam FactorNum Numerator of the correction factor
+  @tparam FactorDen Denominator of the correction factor
+  @details Nominal scale factor, measurement interval and configuration value are constexpr.
+  update() reads data and status in a single transaction and does not call any virtual function.
+  The calibration (setCorrection/setCalibration) is applied to the measured data as UnitADS1110.
+  Any configuration other than the fixed sampling rate and PGA is refused, even through UnitADS1110& or
+  UnitADS11XX& (writePGA, startPeriodicMeasurement(rate, pga), etc.), so the data always match the constexpr scale
+  @note begin() uses only start_periodic of config(). The sampling rate, PGA and factor are the template arguments
+  @note Default factor is same as UnitADS1110 (100/610)
+ */
+template <ads1110::Sampling Rate, ads1110::PGA Gain, uint32_t FactorNum = 100, uint32_t FactorDen = 610>
+class UnitADS1110Fixed final : public UnitADS1110 {
+    static_assert(FactorNum && FactorDen, "Factor must not be zero");
+
+public:
+    //! @brief Configuration value for periodic measurement
+    static constexpr uint8_t CONFIG_VALUE{static_cast<uint8_t>((m5::stl::to_underlying(Rate) << 2) |
+                                                               m5::stl::to_underlying(Gain))};
+    //! @brief Periodic measurement interval(ms)
+    static constexpr uint32_t INTERVAL{ads1110::interval(Rate)};
+    //! @brief Voltage(mV) per LSB
+    static constexpr float LSB_VOLTAGE{ads11xx::lsb_voltage(m5::stl::to_underlying(Rate), Gain, 2048.f,
+                                                            static_cast<float>(FactorNum) / FactorDen)};
+
+    //! @brief Voltage(uV) per LSB in Q16.16
+    static constexpr uint32_t LSB_Q16{static_cast<uint32_t>(
+        2048.0 * 1000.0 * 65536.0 * FactorDen /
+            (-static_cast<double>(ads11xx::min_code(m5::stl::to_underlying(Rate))) *
+             (1U << m5::stl::to_underlying(Gain)) * FactorNum) +
+        0.5)};
+
+    //! @brief Raw value to nominal voltage(mV) (Without calibration)
+    static constexpr float raw_to_voltage(const int16_t raw)
+    {
+        return raw * LSB_VOLTAGE;
+    }
+    //! @brief Raw value to nominal voltage(uV) without floating point operations (Without calibration)
+    static inline int32_t raw_to_microvoltage(const int16_t raw)
+    {
+        return m5::unit::anadig::adc_code_to_microvoltage(raw, LSB_Q16);
+    }
+
+    explicit UnitADS1110Fixed(const uint8_t addr = DEFAULT_ADDRESS)
+        : UnitADS1110(static_cast<float>(FactorNum) / FactorDen, addr)
+    {
+        auto cfg          = config();
+        cfg.sampling_rate = Rate;
+        cfg.pga           = Gain;
+        UnitADS1110::config(cfg);
+        _fixed_settings = CONFIG_VALUE;
+    }
+    virtual ~UnitADS1110Fixed()
+    {
+    }
+
+    //! @brief Program the fixed settings, and start periodic measurement if config().start_periodic
+    virtual bool begin() override
+    {
+        return UnitADS11XX::begin() && (config().start_periodic ? startPeriodicMeasurement() : write_single());
+    }
+    //! @brief General reset, and program the fixed settings
+    virtual bool generalReset() override
+    {
+        return UnitADS11XX::generalReset() && write_single();
+    }
+
+    ///@note Deleted as they change the fixed settings
+    ///@name Settings
+    ///@{
+    using UnitADS1110::config;
+    void config(const config_t& cfg) = delete;
+    //! @brief Deleted
+    bool writePGA(const ads11xx::PGA pga) = delete;
+    //! @brief Deleted
+    bool writeSamplingRate(const ads1110::Sampling rate) = delete;
+    ///@}
+
+    ///@name Single shot measurement
+    ///@{
+    //! @brief Measurement single shot using fixed settings
+    inline bool measureSingleshot(ads1110::Data& data)
+    {
+        return measure_singleshot(data, CONFIG_VALUE);
+    }
+    bool measureSingleshot(ads1110::Data& data, const ads1110::Sampling rate, const ads1110::PGA pga) = delete;
+    ///@}
+
+    virtual void update(const bool force = false) override
+    {
+        _updated = false;
+        if (inPeriodic()) {
+            elapsed_time_t at{m5::utility::millis()};
+            if (force || !_latest || at >= _latest + INTERVAL) {
+                const uint32_t arrived_us = static_cast<uint32_t>(m5::utility::micros());
+                uint8_t rbuf[3]{};
+                if (read_measurement_and_config(rbuf) && ((rbuf[2] & 0x80) == 0)) {
+                    ads11xx::Data d{};
+                    d.raw[0] = rbuf[0];
+                    d.raw[1] = rbuf[1];
+                    store_periodic(d, at, arrived_us);  // Same stages and calibrated scale as UnitADS11XX
+                }
+            }
+        }
+    }
+
+    ///@name Periodic measurement
+    ///@{
+    //! @brief Start periodic measurement using fixed settings
+    inline bool startPeriodicMeasurement()
+    {
+        return UnitADS11XX::start_periodic_measurement(CONFIG_VALUE);
+    }
+    ///@}
+
+protected:
+    using elapsed_time_t = m5::unit::types::elapsed_time_t;
+
+    // Fixed settings in single mode (Stops periodic measurement)
+    bool write_single()
+    {
+        Config c{};
+        c.value = CONFIG_VALUE;
+        c.single(true);
+        if (write_config(c.value)) {
+            _periodic = false;
+            return true;
+        }
+        return false;
+    }
+};
+
+///@cond
+template <ads1110::Sampling Rate, ads1110::PGA Gain, uint32_t FactorNum, uint32_t FactorDen>
+constexpr uint8_t UnitADS1110Fixed<Rate, Gain, FactorNum, FactorDen>::CONFIG_VALUE;
+template <ads1110::Sampling Rate, ads1110::PGA Gain, uint32_t FactorNum, uint32_t FactorDen>
+constexpr uint32_t UnitADS1110Fixed<Rate, Gain, FactorNum, FactorDen>::INTERVAL;
+template <ads1110::Sampling Rate, ads1110::PGA Gain, uint32_t FactorNum, uint32_t FactorDen>
+constexpr float UnitADS1110Fixed<Rate, Gain, FactorNum, FactorDen>::LSB_VOLTAGE;
+template <ads1110::Sampling Rate, ads1110::PGA Gain, uint32_t FactorNum, uint32_t FactorDen>
+constexpr uint32_t UnitADS1110Fixed<Rate, Gain, FactorNum, FactorDen>::LSB_Q16;
+///@endcond
+
 }  // namespace unit
 }  // namespace m5
 #endif
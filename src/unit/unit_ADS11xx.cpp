@@ -50,6 +50,7 @@ bool UnitADS11XX::begin()
     }
     _pga  = c.pga();
     _rate = c.rate();
+    update_scale();
     return true;
 }
 
@@ -59,20 +60,33 @@ void UnitADS11XX::update(const bool force)
     if (inPeriodic()) {
         elapsed_time_t at{m5::utility::millis()};
         if (force || !_latest || at >= _latest + _interval) {
+            const uint32_t arrived_us = static_cast<uint32_t>(m5::utility::micros());
             Data d{};
-            _updated = read_if_ready_in_periodic(d.raw.data());
-            if (_updated) {
-                d.pga    = _pga;
-                d.rate   = _rate;
-                d.vdd    = _vdd;
-                d.factor = _factor;
-                _data->push_back(d);
-                _latest = at;
+            if (read_if_ready_in_periodic(d.raw.data())) {
+                store_periodic(d, at, arrived_us);
             }
         }
     }
 }
 
+void UnitADS11XX::store_periodic(ads11xx::Data& d, const types::elapsed_time_t at, const uint32_t arrived_us)
+{
+    if (_hum.enabled()) {
+        const int16_t v = _hum.process(d.differentialValue());
+        d.raw[0]        = (v >> 8) & 0xFF;
+        d.raw[1]        = v & 0xFF;
+    }
+    d.pga       = _pga;
+    d.rate      = _rate;
+    d.vdd       = _vdd;
+    d.factor    = _scaled_factor;
+    d.lsb_q16   = _lsb_q16;
+    d.offset_uv = _offset_uv;
+    d.transfer  = _transfer;
+    _updated    = store_data(d, at, arrived_us);
+    _latest     = at;
+}
+
 bool UnitADS11XX::start_periodic_measurement(const uint8_t cfg_value)
 {
     if (inPeriodic()) {
@@ -89,6 +103,9 @@ bool UnitADS11XX::start_periodic_measurement(const uint8_t cfg_value)
         _interval = get_interval(c.rate());
         _latest   = 0;
         read_config(c.value);
+        if (_hum.config().enable && !_hum.begin(get_sampling_rate(_rate), _hum.config())) {
+            M5_LIB_LOGW("Hum rejection is disabled at this sampling rate");
+        }
     }
     return _periodic;
 }
@@ -128,10 +145,13 @@ bool UnitADS11XX::measure_singleshot(ads11xx::Data& data, const uint8_t cfg_valu
         auto timeout_at = m5::utility::millis() + 1000;
         do {
             if (is_data_ready() && read_measurement(data.raw.data())) {
-                data.pga    = _pga;
-                data.rate   = _rate;
-                data.vdd    = _vdd;
-                data.factor = _factor;
+                data.pga       = _pga;
+                data.rate      = _rate;
+                data.vdd       = _vdd;
+                data.factor    = _scaled_factor;
+                data.lsb_q16   = _lsb_q16;
+                data.offset_uv = _offset_uv;
+                data.transfer  = _transfer;
                 return true;
             }
         } while (m5::utility::millis() <= timeout_at);
@@ -170,6 +190,85 @@ bool UnitADS11XX::writePGA(const ads11xx::PGA pga)
     return false;
 }
 
+bool UnitADS11XX::startCapture(const anadig::CaptureConfig& cfg)
+{
+    if (!_capture.config(cfg)) {
+        M5_LIB_LOGE("Failed to configure capture");
+        return false;
+    }
+    _capture.arm();
+    return true;
+}
+
+int16_t UnitADS11XX::voltageToValue(const float mv) const
+{
+    float v = (mv - _offset_uv * 0.001f) *
+              (-Data::min_code_table[_rate & 0x03] / _vdd * (1U << m5::stl::to_underlying(_pga))) * _scaled_factor;
+    v       = std::round(v);
+    return (v <= -32768.f) ? -32768 : (v >= 32767.f) ? 32767 : static_cast<int16_t>(v);
+}
+
+bool UnitADS11XX::setHumRejection(const anadig::HumConfig& cfg)
+{
+    if (!_hum.begin(get_sampling_rate(_rate), cfg)) {
+        M5_LIB_LOGE("Failed to configure hum rejection");
+        return false;
+    }
+    return true;
+}
+
+bool UnitADS11XX::analyzeStored(anadig::Spectrum& spectrum)
+{
+    if (_deadband.enabled()) {
+        M5_LIB_LOGW("Stored samples are not uniform while the deadband filter is enabled");
+        return false;
+    }
+    const auto& buf = *_data;
+    return spectrum.analyze([&buf](const size_t idx) { return buf[idx].differentialValue(); }, buf.size(),
+                            get_sampling_rate(_rate));
+}
+
+bool UnitADS11XX::analyzeCapture(anadig::Spectrum& spectrum)
+{
+    return _capture.available() && spectrum.analyze(_capture.data(), _capture.size(), get_sampling_rate(_rate));
+}
+
+bool UnitADS11XX::buildTransfer(anadig::TransferTable& table, std::function<float(const float mv)> f,
+                                const uint16_t segments, const bool interpolate) const
+{
+    if (!f) {
+        return false;
+    }
+    const int32_t min_code = Data::min_code_table[_rate & 0x03];
+
+    Data d{};
+    d.rate      = _rate;
+    d.pga       = _pga;
+    d.vdd       = _vdd;
+    d.factor    = _scaled_factor;
+    d.offset_uv = _offset_uv;
+    return table.build(static_cast<int16_t>(min_code), static_cast<int16_t>(-min_code - 1), segments,
+                       [&d, &f](const int16_t code) {
+                           d.raw[0] = (code >> 8) & 0xFF;
+                           d.raw[1] = code & 0xFF;
+                           return f(d.differentialVoltage());
+                       },
+                       interpolate);
+}
+
+void UnitADS11XX::update_scale()
+{
+    const auto& c = _calibration.pga[m5::stl::to_underlying(_pga) & 0x03];
+    Data d{};
+    d.rate         = _rate;
+    d.pga          = _pga;
+    d.vdd          = _vdd;
+    d.factor       = _factor;
+    _lsb_q16       = static_cast<uint32_t>((static_cast<uint64_t>(d.lsbQ16()) * c.gain_q16 + 0x8000) >> 16);
+    _scaled_factor = _factor * 65536.f / c.gain_q16;
+    _offset_uv     = c.offset_uv;
+}
+
 bool UnitADS11XX::generalReset()
 {
     uint8_t cmd{0x06};  // reset command
@@ -191,8 +290,7 @@ bool UnitADS11XX::generalReset()
 bool UnitADS11XX::read_config(uint8_t& v)
 {
     uint8_t rbuf[3]{};  // [0,]:data [2]:config
-    if ((writeWithTransaction(nullptr, 0U) == m5::hal::error::error_t::OK) &&
-        (readWithTransaction(rbuf, 3) == m5::hal::error::error_t::OK)) {
+    if (read_measurement_and_config(rbuf)) {
         v = rbuf[2];
         return true;
     }
@@ -201,11 +299,16 @@ bool UnitADS11XX::read_config(uint8_t& v)
 
 bool UnitADS11XX::write_config(const uint8_t v)
 {
+    if (_fixed_settings >= 0 && ((v ^ _fixed_settings) & 0x0F)) {
+        M5_LIB_LOGE("The sampling rate and PGA are fixed %02X", _fixed_settings);
+        return false;
+    }
     if (writeWithTransaction(&v, 1) == m5::hal::error::error_t::OK) {
         Config c{};
         c.value = v;
         _pga    = c.pga();
         _rate   = c.rate();
+        update_scale();
         return true;
     }
     return false;
@@ -217,6 +320,13 @@ bool UnitADS11XX::read_measurement(uint8_t v[2])
            (readWithTransaction(v, 2) == m5::hal::error::error_t::OK);
 }
 
+// v[0,1]:data v[2]:config
+bool UnitADS11XX::read_measurement_and_config(uint8_t v[3])
+{
+    return (writeWithTransaction(nullptr, 0U) == m5::hal::error::error_t::OK) &&
+           (readWithTransaction(v, 3) == m5::hal::error::error_t::OK);
+}
+
 bool UnitADS11XX::is_data_ready()
 {
     Config c{};
@@ -13,6 +13,15 @@
 #include <m5_utility/stl/extension.hpp>
 #include <m5_utility/container/circular_buffer.hpp>
 #include <limits>  // NaN
+#include "../utility/fixed_point.hpp"
+#include "../utility/calibration.hpp"
+#include "../utility/comparator.hpp"
+#include "../utility/capture.hpp"
+#include "../utility/deadband.hpp"
+#include "../utility/transfer.hpp"
+#include "../utility/hum.hpp"
+#include "../utility/spectrum.hpp"
+#include <functional>
 
 namespace m5 {
 namespace unit {
@@ -34,16 +43,43 @@ enum class PGA : uint8_t {
     Gain8,  //!< 8
 };
 
+/*!
+  @brief Gets the minimum output code for the data rate
+  @param rate Data rate value (Value and content depend on derived class)
+  @note Same values as Data::min_code_table, available at compile time
+ */
+constexpr int32_t min_code(const uint8_t rate)
+{
+    return ((rate & 0x03) == 0) ? -2048 : ((rate & 0x03) == 1) ? -8192 : ((rate & 0x03) == 2) ? -16384 : -32768;
+}
+
+/*!
+  @brief Gets the voltage(mV) per LSB
+  @param rate Data rate value (Value and content depend on derived class)
+  @param pga PGA
+  @param vdd VDD(mV)
+  @param factor Correction factor
+  @note Data::differentialVoltage() is equal to differentialValue() * lsb_voltage(...)
+ */
+constexpr float lsb_voltage(const uint8_t rate, const PGA pga, const float vdd, const float factor)
+{
+    return vdd / (static_cast<float>(-min_code(rate)) * static_cast<float>(1U << m5::stl::to_underlying(pga))) /
+           factor;
+}
+
 /*!
   @struct Data
   @brief Measurement data group
  */
 struct Data {
-    std::array<uint8_t, 2> raw{};  //!< Raw
-    uint8_t rate{};                //!< SPS (Value and content depend on derived class)
-    PGA pga{};                     //!< PGA
-    float vdd{2048.f};             //!< VDD(mV)
-    float factor{1.0f};            //!< Correction factor
+    std::array<uint8_t, 2> raw{};             //!< Raw
+    uint8_t rate{};                           //!< SPS (Value and content depend on derived class)
+    PGA pga{};                                //!< PGA
+    float vdd{2048.f};                        //!< VDD(mV)
+    float factor{1.0f};                       //!< Correction factor (Including the calibrated gain)
+    uint32_t lsb_q16{};                       //!< Voltage(uV) per LSB in Q16.16 (Calculated from other values if zero)
+    int32_t offset_uv{};                      //!< Calibrated offset(uV)
+    const anadig::TransferTable* transfer{};  //!< Transfer table to the engineering value
 
     ///! @brief Gets the differential value
     inline int16_t differentialValue() const
@@ -53,8 +89,29 @@ struct Data {
     //! @brief Gets the differential voltage(mV)
     inline float differentialVoltage() const
     {
-        return differentialValue() / (-min_code_table[rate & 0x03] / vdd * (1U << m5::stl::to_underlying(pga))) /
-               factor;
+        return m5::unit::anadig::adc_code_to_voltage(differentialValue(), min_code_table[rate & 0x03],
+                                                     m5::stl::to_underlying(pga), vdd, factor) +
+               offset_uv * 0.001f;
+    }
+    /*!
+      @brief Gets the differential voltage(uV) without floating point operations
+      @note Error is less than 1 uV against the exact value
+     */
+    inline int32_t differentialMicroVoltage() const
+    {
+        return m5::unit::anadig::adc_code_to_microvoltage(differentialValue(), lsb_q16 ? lsb_q16 : lsbQ16()) +
+               offset_uv;
+    }
+    //! @brief Gets the engineering value by the transfer table (NaN if no table)
+    inline float value() const
+    {
+        return transfer ? transfer->convert(differentialValue()) : std::numeric_limits<float>::quiet_NaN();
+    }
+    //! @brief Gets the voltage(uV) per LSB in Q16.16
+    inline uint32_t lsbQ16() const
+    {
+        return m5::unit::anadig::adc_lsb_microvoltage_q16(min_code_table[rate & 0x03], m5::stl::to_underlying(pga),
+                                                          vdd, factor);
     }
     static const int32_t min_code_table[4];
 };
@@ -95,6 +152,16 @@ public:
     {
         return !empty() ? oldest().differentialVoltage() : std::numeric_limits<float>::quiet_NaN();
     }
+    //! @brief Oldest measured differential voltage(uV) without floating point operations
+    inline int32_t differentialMicroVoltage() const
+    {
+        return !empty() ? oldest().differentialMicroVoltage() : 0;
+    }
+    //! @brief Oldest measured engineering value by the transfer table
+    inline float value() const
+    {
+        return !empty() ? oldest().value() : std::numeric_limits<float>::quiet_NaN();
+    }
     ///@}
 
     ///@name Settings
@@ -114,6 +181,267 @@ public:
     bool writePGA(const ads11xx::PGA pga);
     ///@}
 
+    ///@note Evaluated in update() for each new periodic sample, using raw values
+    ///@name Threshold comparator
+    ///@{
+    /*!
+      @brief Callback on comparator events
+      @param unit This unit
+      @param events Event bits (See also anadig::comparator)
+      @param data Sample that caused the events
+     */
+    using comparator_callback_t =
+        std::function<void(UnitADS11XX& unit, const uint8_t events, const ads11xx::Data& data)>;
+    //! @brief Gets the comparator settings
+    inline const anadig::Threshold& threshold() const
+    {
+        return _comparator.config();
+    }
+    //! @brief Set the comparator settings
+    //! @note Comparator state and latched events are cleared
+    inline void setThreshold(const anadig::Threshold& th)
+    {
+        _comparator.config(th);
+        _comparator_events = 0;
+    }
+    //! @brief Gets the comparator state bits
+    inline uint8_t comparatorState() const
+    {
+        return _comparator.state();
+    }
+    /*!
+      @brief Gets the comparator event bits latched since last call
+      @param clear Clear latched events if true
+     */
+    inline uint8_t comparatorEvents(const bool clear = true)
+    {
+        uint8_t ev = _comparator_events;
+        if (clear) {
+            _comparator_events = 0;
+        }
+        return ev;
+    }
+    //! @brief Set the callback called in update() when events occur
+    inline void setComparatorCallback(comparator_callback_t cb)
+    {
+        _comparator_callback = cb;
+    }
+    /*!
+      @brief Voltage(mV) to raw value using current settings
+      @note For comparator thresholds. Rate, PGA etc. must be set before calling
+     */
+    int16_t voltageToValue(const float mv) const;
+    ///@}
+
+    ///@note Applied to the scale of new samples
+    ///@name Calibration
+    ///@{
+    //! @brief Gets the calibration record
+    inline const anadig::AdcCalibration& calibration() const
+    {
+        return _calibration;
+    }
+    /*!
+      @brief Set the calibration record (e.g. deserialized from NVS)
+      @param cal Calibration record
+      @return True if successful, false if any gain is not positive (Not changed)
+     */
+    inline bool setCalibration(const anadig::AdcCalibration& cal)
+    {
+        if (!cal.valid()) {
+            return false;
+        }
+        _calibration = cal;
+        update_scale();
+        return true;
+    }
+    //! @brief Gets the correction of the PGA
+    inline const anadig::GainOffset& correction(const ads11xx::PGA pga) const
+    {
+        return _calibration.pga[m5::stl::to_underlying(pga) & 0x03];
+    }
+    /*!
+      @brief Set the correction of the PGA
+      @param pga PGA
+      @param correction Correction (e.g. by anadig::two_point_correction or LoopbackSweep::adcCorrection)
+      @return True if successful, false if the gain is not positive (Not changed)
+     */
+    inline bool setCorrection(const ads11xx::PGA pga, const anadig::GainOffset& correction)
+    {
+        if (!correction.valid()) {
+            return false;
+        }
+        _calibration.pga[m5::stl::to_underlying(pga) & 0x03] = correction;
+        update_scale();
+        return true;
+    }
+    ///@}
+
+    ///@note Applied in update() to new periodic samples, before the sample subscription and the following stages
+    ///@note Set up again with the sampling rate on each startPeriodicMeasurement
+    ///@name Mains hum rejection
+    ///@{
+    /*!
+      @brief Set the hum rejection
+      @param cfg Settings
+      @return True if successful
+      @note Fails if the hum aliases to DC at the current sampling rate (Already rejected by the ADC)
+     */
+    bool setHumRejection(const anadig::HumConfig& cfg);
+    //! @brief Gets the hum rejector
+    inline const anadig::HumRejector& humRejector() const
+    {
+        return _hum;
+    }
+    //! @brief Peak amplitude(uV) of the hum in the last detector block
+    inline int32_t humMicroVoltage() const
+    {
+        return static_cast<int32_t>((static_cast<uint64_t>(_hum.detector().amplitude()) * _lsb_q16 + (1U << 23)) >> 24);
+    }
+    ///@}
+
+    ///@note The spectrum is in raw values (Q8). Multiply by the voltage per LSB for the voltage
+    ///@name Spectral analysis
+    ///@{
+    /*!
+      @brief Analyze the latest stored samples
+      @param spectrum Analyzer (begin() called)
+      @return True if successful
+      @note The stored size must be at least the FFT size. The sampling rate of the current settings is used
+      @note Fails while the deadband filter is enabled, as the dropped samples break the uniform sampling.
+      Samples missed by late update() calls (Later than the interval) also invalidate the result;
+      use analyzeCapture() if update() cannot keep up
+     */
+    bool analyzeStored(anadig::Spectrum& spectrum);
+    /*!
+      @brief Analyze the frozen window of the triggered capture
+      @param spectrum Analyzer (begin() called)
+      @return True if successful
+      @note The capture size must be at least the FFT size. The sampling rate of the current settings is used
+     */
+    bool analyzeCapture(anadig::Spectrum& spectrum);
+    ///@}
+
+    ///@note The table is indexed by the raw code, so rebuild it after changing the rate, PGA or calibration
+    ///@name Transfer function
+    ///@{
+    /*!
+      @brief Build the transfer table for the current settings
+      @param[out] table Table
+      @param f Transfer function of voltage(mV) (e.g. anadig::ntc_beta, anadig::current_loop)
+      @param segments Number of segments
+      @param interpolate Interpolate between entries if true
+      @return True if successful
+     */
+    bool buildTransfer(anadig::TransferTable& table, std::function<float(const float mv)> f,
+                       const uint16_t segments = 256, const bool interpolate = true) const;
+    //! @brief Gets the transfer table
+    inline const anadig::TransferTable* transfer() const
+    {
+        return _transfer;
+    }
+    //! @brief Set the transfer table used by value() of new samples (nullptr to disable)
+    inline void setTransfer(const anadig::TransferTable* table)
+    {
+        _transfer = (table && table->valid()) ? table : nullptr;
+    }
+    ///@}
+
+    ///@note Called in update() for each new periodic sample (Before report-on-change)
+    ///@name Sample subscription
+    ///@{
+    /*!
+      @brief Callback on a new sample
+      @param unit This unit
+      @param data New sample
+      @param arrived_us Time(us) of m5::utility::micros() just before the sample was read (Excluding the I2C read)
+     */
+    using sample_callback_t =
+        std::function<void(UnitADS11XX& unit, const ads11xx::Data& data, const uint32_t arrived_us)>;
+    /*!
+      @brief Set the callback called in update() for each new sample
+      @note If called from the callback itself, takes effect after the callback returns
+     */
+    inline void setSampleCallback(sample_callback_t cb)
+    {
+        if (_in_sample_callback) {
+            _next_sample_callback    = cb;
+            _sample_callback_pending = true;
+            return;
+        }
+        _sample_callback = cb;
+    }
+    ///@}
+
+    ///@note Samples are pushed in update() for each new periodic sample, using raw values
+    ///@name Triggered capture
+    ///@{
+    /*!
+      @brief Start the triggered capture
+      @param cfg Capture settings
+      @return True if successful
+      @note Banks are allocated on the first call or if the window size is changed
+     */
+    bool startCapture(const anadig::CaptureConfig& cfg);
+    //! @brief Stop the triggered capture
+    inline void stopCapture()
+    {
+        _capture.disarm();
+    }
+    //! @brief Software trigger
+    inline void triggerCapture()
+    {
+        _capture.trigger();
+    }
+    //! @brief Gets the capture (Frozen window, statistics)
+    inline const anadig::Capture& capture() const
+    {
+        return _capture;
+    }
+    //! @brief Is the frozen window available?
+    inline bool captured() const
+    {
+        return _capture.available();
+    }
+    //! @brief Release the frozen window
+    inline void releaseCapture()
+    {
+        _capture.release();
+    }
+    //! @brief Gets the voltage(uV) of the frozen window sample
+    inline int32_t capturedMicroVoltage(const size_t idx) const
+    {
+        return (idx < _capture.size())
+                   ? anadig::adc_code_to_microvoltage(_capture.data()[idx], _capture_lsb_q16) + _capture_offset_uv
+                   : 0;
+    }
+    ///@}
+
+    ///@note Comparator and capture still see every sample
+    ///@name Report-on-change
+    ///@{
+    /*!
+      @brief Set the report-on-change settings
+      @details If enabled, a new sample is stored (and updated() becomes true) only when it moves
+      beyond the deadband from the last stored sample or after the maximum silence interval
+      @note Statistics are cleared
+     */
+    inline void setDeadband(const anadig::DeadbandConfig& cfg)
+    {
+        _deadband.config(cfg);
+    }
+    //! @brief Gets the report-on-change filter (Settings, statistics)
+    inline const anadig::Deadband& deadband() const
+    {
+        return _deadband;
+    }
+    //! @brief Gets the compression ratio achieved by report-on-change (received / stored)
+    inline float compressionRatio() const
+    {
+        return _deadband.ratio();
+    }
+    ///@}
+
     /*!
       @brief General reset
       @details Reset using I2C general call
@@ -133,13 +461,58 @@ protected:
     bool read_config(uint8_t& v);
     bool write_config(const uint8_t v);
     bool read_measurement(uint8_t v[2]);
+    bool read_measurement_and_config(uint8_t v[3]);
     bool is_data_ready();
 
+    // Calculate the calibrated scale for the current settings
+    void update_scale();
+    // Filter, stamp with the current scale and store the periodic sample read in update()
+    void store_periodic(ads11xx::Data& d, const types::elapsed_time_t at, const uint32_t arrived_us);
+
+    // Return true if stored
+    inline bool store_data(const ads11xx::Data& d, const types::elapsed_time_t at, const uint32_t arrived_us)
+    {
+        if (_sample_callback) {
+            // Replacing the callback while it runs would destroy the running function object
+            _in_sample_callback = true;
+            _sample_callback(*this, d, arrived_us);
+            _in_sample_callback = false;
+            if (_sample_callback_pending) {
+                _sample_callback         = std::move(_next_sample_callback);
+                _next_sample_callback    = nullptr;
+                _sample_callback_pending = false;
+            }
+        }
+        const int16_t v = d.differentialValue();
+        if (_capture.armed() && _capture.push(v)) {
+            _capture_lsb_q16   = d.lsb_q16;
+            _capture_offset_uv = d.offset_uv;
+        }
+        if (_comparator.enabled()) {
+            auto ev = _comparator.evaluate(v);
+            if (ev) {
+                _comparator_events |= ev;
+                if (_comparator_callback) {
+                    _comparator_callback(*this, ev, d);
+                }
+            }
+        }
+        if (_deadband.enabled() && !_deadband.pass(v, static_cast<uint32_t>(at))) {
+            return false;
+        }
+        _data->push_back(d);
+        return true;
+    }
+
     virtual bool read_if_ready_in_periodic(uint8_t v[2]);
     virtual uint32_t get_interval(const uint8_t /* rate */)
     {
         return 0;
     }
+    virtual float get_sampling_rate(const uint8_t /* rate */)
+    {
+        return 0.0f;
+    }
 
     M5_UNIT_COMPONENT_PERIODIC_MEASUREMENT_ADAPTER_HPP_BUILDER(UnitADS11XX, ads11xx::Data);
 
@@ -149,6 +522,26 @@ protected:
     uint8_t _rate{};
     float _vdd{2.048f};
     float _factor{1.0f};
+    anadig::AdcCalibration _calibration{};
+    float _scaled_factor{1.0f};  // Including the calibrated gain
+    uint32_t _lsb_q16{};         // Calibrated
+    int32_t _offset_uv{};        // Calibrated
+    const anadig::TransferTable* _transfer{};
+    int16_t _fixed_settings{-1};  // Rate and PGA bits of the config if fixed (UnitADS1110Fixed)
+
+    anadig::Comparator _comparator{};
+    uint8_t _comparator_events{};
+    comparator_callback_t _comparator_callback{};
+    sample_callback_t _sample_callback{};
+    sample_callback_t _next_sample_callback{};
+    bool _in_sample_callback{}, _sample_callback_pending{};
+
+    anadig::Capture _capture{};
+    uint32_t _capture_lsb_q16{};
+    int32_t _capture_offset_uv{};
+
+    anadig::Deadband _deadband{};
+    anadig::HumRejector _hum{};
 
     struct Config {
         inline uint8_t rate() const
@@ -24,6 +24,10 @@ constexpr float max_mv_table[] = {
     5000.f,
     10000.f,
 };
+constexpr m5::unit::anadig::CodeScale scale_table[] = {
+    m5::unit::anadig::CodeScale(m5::unit::UnitGP8413::RESOLUTION, 5000 * 1000U, 5000 * 1000U),
+    m5::unit::anadig::CodeScale(m5::unit::UnitGP8413::RESOLUTION, 10000 * 1000U, 10000 * 1000U),
+};
 /*
   **** NOTICE *******************************************************************************************
   The datasheet says that when changing the output voltage range, use 0x00 for 5V and 0x01 for 10V.
@@ -58,36 +62,266 @@ bool UnitGP8413::begin()
     return writeOutputRange(_cfg.range0, _cfg.range1);
 }
 
+void UnitGP8413::update(const bool force)
+{
+    (void)force;
+    update_setpoints();
+    update_store();
+    update_ramp();
+}
+
+void UnitGP8413::update_setpoints()
+{
+    if (_setpoints.empty()) {
+        return;
+    }
+    // Setpoints of both channels due at the same time are output in one transaction
+    bool staged[2]{};
+    uint16_t raw[2]{};
+    _setpoints.dispatch(
+        m5::utility::micros(),
+        [&staged, &raw](const uint8_t ch, const uint16_t code) {
+            if (ch >= 2) {
+                return false;
+            }
+            staged[ch] = true;
+            raw[ch]    = code;
+            return true;
+        },
+        [this, &staged, &raw]() {
+            if (staged[0] && staged[1]) {
+                return writeBothVoltage(raw[0], raw[1]);
+            }
+            const Channel ch = staged[0] ? Channel::Zero : Channel::One;
+            return writeVoltage(ch, raw[m5::stl::to_underlying(ch)]);
+        });
+}
+
+bool UnitGP8413::rampMicroVoltage(const gp8413::Channel channel, const int32_t uv, const uint32_t rate_mv_per_s,
+                                  const bool s_curve)
+{
+    if (uv < 0) {
+        return false;
+    }
+    _ramp[m5::stl::to_underlying(channel)].start(raw_to_microvoltage(channel, lastValue(channel)), uv, rate_mv_per_s,
+                                                 s_curve, m5::utility::micros());
+    update_ramp();
+    return true;
+}
+
+void UnitGP8413::update_ramp()
+{
+    // The position is time-based, so the output catches up after the store
+    if (storeBusy()) {
+        return;
+    }
+    bool changed[2]{};
+    uint16_t raw[2]{};
+    const auto now = m5::utility::micros();
+    for (uint_fast8_t i = 0; i < 2; ++i) {
+        if (_ramp[i].active()) {
+            raw[i]     = microvoltage_to_raw(static_cast<Channel>(i), _ramp[i].update(now));
+            changed[i] = (raw[i] != _last_raw[i]);
+        }
+    }
+    if (changed[0] && changed[1]) {
+        writeBothVoltage(raw[0], raw[1]);
+    } else if (changed[0] || changed[1]) {
+        const Channel ch = changed[0] ? Channel::Zero : Channel::One;
+        writeVoltage(ch, raw[m5::stl::to_underlying(ch)]);
+    }
+}
+
+void UnitGP8413::update_store()
+{
+    if (_store_state != StoreState::Storing || (int32_t)(m5::utility::millis() - _store_done_at) < 0) {
+        return;
+    }
+    _store_state = StoreState::Idle;
+
+    // Apply deferred outputs
+    if (_has_pending[0] && _has_pending[1]) {
+        writeBothVoltage(_pending_raw[0], _pending_raw[1]);
+    } else if (_has_pending[0] || _has_pending[1]) {
+        const Channel ch = _has_pending[0] ? Channel::Zero : Channel::One;
+        writeVoltage(ch, _pending_raw[m5::stl::to_underlying(ch)]);
+    }
+    _has_pending[0] = _has_pending[1] = false;
+
+    if (_store_callback) {
+        _store_callback(*this);
+    }
+}
+
 bool UnitGP8413::writeOutputRange(const gp8413::Output range0, const gp8413::Output range1)
 {
+    if (storeBusy()) {
+        M5_LIB_LOGD("Storing is in progress");
+        return false;
+    }
     uint8_t v =
         mode_nibble_table[m5::stl::to_underlying(range0)] | (mode_nibble_table[m5::stl::to_underlying(range1)] << 4);
 
     if (writeRegister8(OUTPUT_RANGE_REG, v)) {
-        _range[0] = range0;
-        _range[1] = range1;
+        // The correction is for the previous range
+        _correction[0] = (range0 == _range[0]) ? _correction[0] : nullptr;
+        _correction[1] = (range1 == _range[1]) ? _correction[1] : nullptr;
+        _range[0]      = range0;
+        _range[1]      = range1;
+        update_scale();
         return true;
     }
     return false;
 }
 
+bool UnitGP8413::switchOutputRange(const gp8413::Output range0, const gp8413::Output range1)
+{
+    const Output range[2]{range0, range1};
+    uint16_t raw[2]{};
+    for (uint_fast8_t i = 0; i < 2; ++i) {
+        if (range[i] == _range[i]) {
+            raw[i] = _last_raw[i];
+            continue;
+        }
+        // The correction is dropped on the range change, so the new range converts through the nominal scale
+        const auto& to   = scale_table[m5::stl::to_underlying(range[i])];
+        const int32_t uv = raw_to_microvoltage(static_cast<Channel>(i), _last_raw[i]);
+        if (uv > static_cast<int32_t>(to.clamp_uv)) {
+            M5_LIB_LOGW("The voltage of channel %u exceeds the range", i);
+            return false;
+        }
+        raw[i] = to.to_code(uv);
+    }
+    return write_range_and_voltage(range, raw);
+}
+
+gp8413::Output UnitGP8413::finestRange(const int32_t uv)
+{
+    return (uv <= static_cast<int32_t>(scale_table[0].clamp_uv)) ? Output::Range5V : Output::Range10V;
+}
+
+bool UnitGP8413::writeMicroVoltageAutoRange(const gp8413::Channel channel, const int32_t uv)
+{
+    if (uv < 0) {
+        return false;
+    }
+    const auto idx = m5::stl::to_underlying(channel);
+    Output range[2]{_range[0], _range[1]};
+    uint16_t raw[2]{_last_raw[0], _last_raw[1]};
+    range[idx] = finestRange(uv);
+    // Same as writeMicroVoltage() if the range is kept (the correction is dropped on the range change)
+    raw[idx] = (range[idx] == _range[idx]) ? microvoltage_to_raw(channel, uv)
+                                           : scale_table[m5::stl::to_underlying(range[idx])].to_code(uv);
+    return write_range_and_voltage(range, raw);
+}
+
+bool UnitGP8413::write_range_and_voltage(const gp8413::Output range[2], const uint16_t raw[2])
+{
+    if (storeBusy()) {
+        M5_LIB_LOGD("Storing is in progress");
+        return false;
+    }
+
+    // The output during the switch is either the new raw value in the old range (code first),
+    // or the old raw value in the new range (range first). Choose the one not exceeding the old and new voltages
+    bool before[2]{}, after[2]{};
+    for (uint_fast8_t i = 0; i < 2; ++i) {
+        if (range[i] == _range[i]) {
+            before[i] = (raw[i] != _last_raw[i]);
+            continue;
+        }
+        // The old range converts through the current correction, the new one through the nominal scale
+        const auto ch         = static_cast<Channel>(i);
+        const auto& to        = scale_table[m5::stl::to_underlying(range[i])];
+        const int32_t v_old   = raw_to_microvoltage(ch, _last_raw[i]);
+        const int32_t v_new   = to.to_microvoltage(raw[i]);
+        const int32_t hi      = (v_old > v_new) ? v_old : v_new;
+        const int32_t v_code  = raw_to_microvoltage(ch, raw[i]);
+        const int32_t v_range = to.to_microvoltage(_last_raw[i]);
+        bool code_first{};
+        if ((v_code <= hi) != (v_range <= hi)) {
+            code_first = (v_code <= hi);
+        } else {
+            // Both within: the smaller dip, both exceeding: the smaller overshoot
+            code_first = (v_code <= hi) ? (v_code >= v_range) : (v_code < v_range);
+        }
+        before[i] = code_first;
+        after[i]  = !code_first;
+    }
+
+    if (!write_masked_voltage(before, raw)) {
+        return false;
+    }
+    if ((range[0] != _range[0] || range[1] != _range[1]) && !writeOutputRange(range[0], range[1])) {
+        return false;
+    }
+    return write_masked_voltage(after, raw);
+}
+
+bool UnitGP8413::write_masked_voltage(const bool mask[2], const uint16_t raw[2])
+{
+    if (mask[0] && mask[1]) {
+        return writeBothVoltage(raw[0], raw[1]);
+    }
+    if (mask[0] || mask[1]) {
+        const Channel ch = mask[0] ? Channel::Zero : Channel::One;
+        return writeVoltage(ch, raw[m5::stl::to_underlying(ch)]);
+    }
+    return true;
+}
+
 bool UnitGP8413::writeVoltage(const gp8413::Channel channel, const uint16_t raw)
 {
+    const auto idx = m5::stl::to_underlying(channel);
+    if (storeBusy()) {
+        _pending_raw[idx] = raw;
+        _has_pending[idx] = true;
+        return true;
+    }
     uint8_t buf[2]{(uint8_t)(raw & 0xFF), (uint8_t)(raw >> 8)};
-    return write_voltage(channel_reg_table[m5::stl::to_underlying(channel)], buf, 2);
+    if (write_voltage(channel_reg_table[idx], buf, 2)) {
+        _last_raw[idx] = raw;
+        return true;
+    }
+    return false;
 }
 
 bool UnitGP8413::writeBothVoltage(const uint16_t raw0, const uint16_t raw1)
 {
+    if (storeBusy()) {
+        _pending_raw[0] = raw0;
+        _pending_raw[1] = raw1;
+        _has_pending[0] = _has_pending[1] = true;
+        return true;
+    }
     uint8_t buf[4]{(uint8_t)(raw0 & 0xFF), (uint8_t)(raw0 >> 8), (uint8_t)(raw1 & 0xFF), (uint8_t)(raw1 >> 8)};
-    return write_voltage(channel_reg_table[0], buf, 4);
+    if (write_voltage(channel_reg_table[0], buf, 4)) {
+        _last_raw[0] = raw0;
+        _last_raw[1] = raw1;
+        return true;
+    }
+    return false;
 }
 
-uint16_t UnitGP8413::voltage_to_raw(const Channel channel, const float mv)
+uint16_t UnitGP8413::microvoltage_to_raw(const gp8413::Channel channel, const int32_t uv) const
 {
-    float maxMv = maximumVoltage(channel);
-    float val   = std::fmin(std::fmax(mv, 0.0f), maxMv);
-    return static_cast<uint16_t>((val / maxMv) * RESOLUTION);
+    const auto idx = m5::stl::to_underlying(channel);
+    return _correction[idx] ? _correction[idx]->to_code(uv) : _scale[idx].to_code(uv);
+}
+
+int32_t UnitGP8413::raw_to_microvoltage(const gp8413::Channel channel, const uint16_t raw) const
+{
+    const auto idx = m5::stl::to_underlying(channel);
+    return _correction[idx] ? _correction[idx]->to_microvoltage(raw) : _scale[idx].to_microvoltage(raw);
+}
+
+void UnitGP8413::update_scale()
+{
+    for (uint_fast8_t i = 0; i < 2; ++i) {
+        const auto r = m5::stl::to_underlying(_range[i]);
+        _scale[i]    = scale_table[r];
+        _fscale[i]   = m5::unit::anadig::FloatCodeScale(RESOLUTION, max_mv_table[r], max_mv_table[r]);
+    }
 }
 
 bool UnitGP8413::write_voltage(const uint8_t reg, const uint8_t* buf, const uint32_t len)
@@ -97,12 +331,61 @@ bool UnitGP8413::write_voltage(const uint8_t reg, const uint8_t* buf, const uint
 
 bool UnitGP8413::storeBothVoltage()
 {
-    if (writeWithTransaction(store_commad, m5::stl::size(store_commad)) == m5::hal::error::error_t::OK) {
+    if (storeBusy()) {
+        M5_LIB_LOGD("Storing is in progress");
+        return false;
+    }
+    if (send_store_command()) {
         m5::utility::delay(store_wait_ms);
         return true;
     }
     return false;
 }
 
+bool UnitGP8413::storeBothVoltageAsync(const bool force)
+{
+    if (storeBusy()) {
+        M5_LIB_LOGD("Storing is in progress");
+        return false;
+    }
+    if (!force && _has_stored && _stored_raw[0] == _last_raw[0] && _stored_raw[1] == _last_raw[1]) {
+        ++_store_skipped;
+        return true;
+    }
+    if (send_store_command()) {
+        _store_done_at = m5::utility::millis() + store_wait_ms;
+        _store_state   = StoreState::Storing;
+        return true;
+    }
+    return false;
+}
+
+bool UnitGP8413::setupPersistence(m5::unit::anadig::PersistenceManager& pm, const uint32_t settle_ms)
+{
+    if (!pm.begin(
+            2,
+            [this](const uint16_t* values, const uint8_t) {
+                return writeBothVoltage(values[0], values[1]) && storeBothVoltageAsync(true);
+            },
+            [this]() { return storeBusy(); }, settle_ms)) {
+        return false;
+    }
+    if (_has_stored) {
+        pm.setStored(_stored_raw);
+    }
+    return true;
+}
+
+bool UnitGP8413::send_store_command()
+{
+    if (writeWithTransaction(store_commad, m5::stl::size(store_commad)) == m5::hal::error::error_t::OK) {
+        _stored_raw[0] = _last_raw[0];
+        _stored_raw[1] = _last_raw[1];
+        _has_stored    = true;
+        return true;
+    }
+    return false;
+}
+
 }  // namespace unit
 }  // namespace m5
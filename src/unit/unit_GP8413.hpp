@@ -10,10 +10,18 @@
 #ifndef M5_UNIT_ANADIG_UNIT_GP8413_HPP
 #define M5_UNIT_ANADIG_UNIT_GP8413_HPP
 #include <M5UnitComponent.hpp>
+#include "../utility/fixed_point.hpp"
+#include "../utility/persistence.hpp"
+#include "../utility/ramp.hpp"
+#include "../utility/setpoint_queue.hpp"
+#include "../utility/linearity.hpp"
+#include <functional>
 
 namespace m5 {
 namespace unit {
 
+class DACGroup;
+
 /*!
   @namespace gp8413
   @brief For GP8413
@@ -30,6 +38,15 @@ enum class Channel : uint8_t {
     One,   //!< channel 1
 };
 
+/*!
+  @enum StoreState
+  @brief State of the non-blocking store
+ */
+enum class StoreState : uint8_t {
+    Idle,     //!< Not storing
+    Storing,  //!< Storing in progress
+};
+
 }  // namespace gp8413
 
 /*!
@@ -42,6 +59,9 @@ class UnitGP8413 : public Component {
 public:
     static constexpr uint16_t RESOLUTION{0x7FFF};  // 15bits
 
+    //! @brief Callback on completion of the non-blocking store
+    using store_callback_t = std::function<void(UnitGP8413& unit)>;
+
     /*!
       @struct config_t
       @brief Settings for begin
@@ -58,12 +78,14 @@ public:
         auto ccfg  = component_config();
         ccfg.clock = 400 * 1000U;
         component_config(ccfg);
+        update_scale();
     }
     virtual ~UnitGP8413()
     {
     }
 
     virtual bool begin() override;
+    virtual void update(const bool force = false) override;
 
     ///@name Settings for begin
     ///@{
@@ -86,6 +108,11 @@ public:
     {
         return _range[m5::stl::to_underlying(channel)];
     }
+    //! @brief Gets the last output raw value of the channel
+    inline uint16_t lastValue(const gp8413::Channel channel) const
+    {
+        return _last_raw[m5::stl::to_underlying(channel)];
+    }
     //! @brief Get the maximum voltage of the channel
     float maximumVoltage(const gp8413::Channel channel) const;
     /*!
@@ -93,8 +120,21 @@ public:
       @param  range0 Output range to channel 0
       @param  range1 Output range to channel 1
       @return True if successful
+      @note Fails while the non-blocking store is in progress
      */
     bool writeOutputRange(const gp8413::Output range0, const gp8413::Output range1);
+    /*!
+      @brief Switch the output range keeping the output voltage
+      @param  range0 Output range to channel 0
+      @param  range1 Output range to channel 1
+      @return True if successful
+      @note The raw values are recalculated for the new range, and written before or after the range
+      so that the output does not exceed the old and new voltages during the switch
+      @note Fails if the current voltage exceeds the new range, or while the non-blocking store is in progress
+     */
+    bool switchOutputRange(const gp8413::Output range0, const gp8413::Output range1);
+    //! @brief Gets the finest range for the voltage(uV)
+    static gp8413::Output finestRange(const int32_t uv);
     ///@}
 
     ///@name Output the voltage
@@ -132,7 +172,8 @@ public:
     template <typename T, typename std::enable_if<std::is_floating_point<T>::value, std::nullptr_t>::type = nullptr>
     inline bool writeBothVoltage(const T mv0, const T mv1)
     {
-        return writeBothVoltage(voltage_to_raw(gp8413::Channel::Zero, (float)mv0),
+        return (mv0 >= 0.0f) && (mv1 >= 0.0f) &&
+               writeBothVoltage(voltage_to_raw(gp8413::Channel::Zero, (float)mv0),
                                 voltage_to_raw(gp8413::Channel::One, (float)mv1));
     }
     /*!
@@ -148,6 +189,112 @@ public:
     }
     ///@}
 
+    ///@name Output the voltage without floating point operations
+    ///@{
+    /*!
+      @brief Output the voltage
+      @param channel Channel to output
+      @param uv Output voltage(uV)
+      @return True if successful
+      @Note If exceeding the range, it will be kept within the range
+     */
+    inline bool writeMicroVoltage(const gp8413::Channel channel, const int32_t uv)
+    {
+        return (uv >= 0) && writeVoltage(channel, microvoltage_to_raw(channel, uv));
+    }
+    /*!
+      @brief Output the voltage to both channel
+      @param uv0 Output voltage(uV) to channel 0
+      @param uv1 Output voltage(uV) to channel 1
+      @return True if successful
+    */
+    inline bool writeBothMicroVoltage(const int32_t uv0, const int32_t uv1)
+    {
+        return writeBothVoltage(microvoltage_to_raw(gp8413::Channel::Zero, uv0),
+                                microvoltage_to_raw(gp8413::Channel::One, uv1));
+    }
+    //! @brief Voltage(uV) to raw value for the channel
+    uint16_t microvoltage_to_raw(const gp8413::Channel channel, const int32_t uv) const;
+    //! @brief Raw value to voltage(uV) for the channel
+    int32_t raw_to_microvoltage(const gp8413::Channel channel, const uint16_t raw) const;
+    /*!
+      @brief Gets the nominal scale between voltage(uV) and raw value of the current range
+      @note The correction is not applied. Pass microvoltage_to_raw as the code function of
+      anadig::WaveformGenerator::build for the corrected output
+     */
+    inline const m5::unit::anadig::CodeScale& scale(const gp8413::Channel channel) const
+    {
+        return _scale[m5::stl::to_underlying(channel)];
+    }
+    /*!
+      @brief Convert the voltages(mV) to raw values for the channel in a single pass
+      @param channel Channel
+      @param[out] raw Raw values
+      @param mv Voltages(mV)
+      @param num Number of values
+      @note Uses the scale cached for the current range
+     */
+    inline void convertToRaw(const gp8413::Channel channel, uint16_t* raw, const float* mv, const size_t num) const
+    {
+        if (!raw || !mv) {
+            return;
+        }
+        const auto idx = m5::stl::to_underlying(channel);
+        if (_correction[idx]) {
+            for (size_t i = 0; i < num; ++i) {
+                raw[i] = voltage_to_raw(channel, mv[i]);
+            }
+            return;
+        }
+        _fscale[idx].to_codes(raw, mv, num);
+    }
+    ///@}
+
+    ///@note Applied to the voltage conversions of the unit (Float and uV)
+    ///@note Cleared when the range of the channel is changed
+    ///@name Linearity correction
+    ///@{
+    /*!
+      @brief Set the correction of the channel (e.g. built by LoopbackSweep)
+      @param channel Channel
+      @param correction Correction measured in the current range, or nullptr to clear
+      @warning The correction must outlive the use by this unit
+     */
+    inline void setCorrection(const gp8413::Channel channel, const m5::unit::anadig::DacCorrection* correction)
+    {
+        _correction[m5::stl::to_underlying(channel)] = (correction && correction->valid()) ? correction : nullptr;
+    }
+    //! @brief Gets the correction of the channel (nullptr if not set)
+    inline const m5::unit::anadig::DacCorrection* correction(const gp8413::Channel channel) const
+    {
+        return _correction[m5::stl::to_underlying(channel)];
+    }
+    ///@}
+
+    ///@name Output the voltage with the finest range
+    ///@{
+    /*!
+      @brief Output the voltage switching to the finest range
+      @param channel Channel to output
+      @param mv Output voltage(mV)
+      @return True if successful
+      @note The range is switched without exceeding the old and new voltages
+      @note Fails while the non-blocking store is in progress
+     */
+    template <typename T, typename std::enable_if<std::is_floating_point<T>::value, std::nullptr_t>::type = nullptr>
+    inline bool writeVoltageAutoRange(const gp8413::Channel channel, const T mv)
+    {
+        return (mv >= 0.0f) && writeMicroVoltageAutoRange(channel, static_cast<int32_t>(mv * 1000));
+    }
+    /*!
+      @brief Output the voltage switching to the finest range without floating point operations
+      @param channel Channel to output
+      @param uv Output voltage(uV)
+      @return True if successful
+     */
+    bool writeMicroVoltageAutoRange(const gp8413::Channel channel, const int32_t uv);
+    ///@}
+
     ///@name Output the raw value
     ///@{
     /*!
@@ -185,6 +332,69 @@ public:
     }
     ///@}
 
+    ///@note The setpoints are issued in update() (Call it from loop() or a dedicated task)
+    ///@note The queue is empty until allocated by setpointQueue().begin()
+    ///@note Setpoints of both channels due at the same time are output by one writeBothVoltage
+    ///@name Setpoint queue
+    ///@{
+    //! @brief Gets the setpoint queue (Channel is the value of gp8413::Channel)
+    inline m5::unit::anadig::SetpointQueue& setpointQueue()
+    {
+        return _setpoints;
+    }
+    /*!
+      @brief Push the setpoint
+      @param at_us Deadline(us) of m5::utility::micros()
+      @param channel Channel
+      @param raw Output voltage raw value
+      @return True if successful
+     */
+    inline bool pushSetpoint(const uint32_t at_us, const gp8413::Channel channel, const uint16_t raw)
+    {
+        return _setpoints.push(at_us, m5::stl::to_underlying(channel), raw);
+    }
+    ///@}
+
+    ///@note The ramp is advanced in update() and the output is written only when the code changes
+    ///@note Outputs by other functions during the ramp are overwritten
+    ///@name Ramp
+    ///@{
+    /*!
+      @brief Start the ramp from the current output to the target
+      @param channel Channel
+      @param mv Target voltage(mV)
+      @param rate_mv_per_s Slew rate(mV/s)
+      @param s_curve Use S-curve if true
+      @return True if successful
+     */
+    template <typename T, typename std::enable_if<std::is_floating_point<T>::value, std::nullptr_t>::type = nullptr>
+    inline bool rampVoltage(const gp8413::Channel channel, const T mv, const uint32_t rate_mv_per_s,
+                            const bool s_curve = false)
+    {
+        return (mv >= 0.0f) && rampMicroVoltage(channel, static_cast<int32_t>(mv * 1000), rate_mv_per_s, s_curve);
+    }
+    /*!
+      @brief Start the ramp from the current output to the target without floating point operations
+      @param channel Channel
+      @param uv Target voltage(uV)
+      @param rate_mv_per_s Slew rate(mV/s)
+      @param s_curve Use S-curve if true
+      @return True if successful
+     */
+    bool rampMicroVoltage(const gp8413::Channel channel, const int32_t uv, const uint32_t rate_mv_per_s,
+                          const bool s_curve = false);
+    //! @brief Is the channel ramping?
+    inline bool ramping(const gp8413::Channel channel) const
+    {
+        return _ramp[m5::stl::to_underlying(channel)].active();
+    }
+    //! @brief Stop the ramp of the channel at the current output
+    inline void stopRamp(const gp8413::Channel channel)
+    {
+        _ramp[m5::stl::to_underlying(channel)].stop();
+    }
+    ///@}
+
     ///@note The GP8413 supports storing voltage data in the chip to ensure that the voltage output state remains
     ///@note in the corresponding state after power-down or start-up.
     ///@name Store output voltage
@@ -198,13 +408,89 @@ public:
     bool storeBothVoltage();
     ///@}
 
+    ///@note The store command is sent and the completion is waited in update()
+    ///@note While storing, outputs are deferred and the last ones are applied on completion
+    ///@name Store output voltage without blocking
+    ///@{
+    /*!
+      @brief Start storing the current output voltage to the chip
+      @param force Store even if the values are unchanged since the last store
+      @return True if started or skipped
+      @note Skipped if the values are the same as the last successful store
+      @note Fails if the previous store is in progress
+     */
+    bool storeBothVoltageAsync(const bool force = false);
+    //! @brief Gets the state of the non-blocking store
+    inline gp8413::StoreState storeState() const
+    {
+        return _store_state;
+    }
+    //! @brief Is the store in progress?
+    inline bool storeBusy() const
+    {
+        return _store_state == gp8413::StoreState::Storing;
+    }
+    //! @brief Number of stores skipped because the values were unchanged
+    inline uint32_t storeSkipped() const
+    {
+        return _store_skipped;
+    }
+    //! @brief Set the callback called in update() on completion
+    inline void setStoreCallback(store_callback_t cb)
+    {
+        _store_callback = cb;
+    }
+    /*!
+      @brief Set up the persistence manager for this unit
+      @param pm Manager
+      @param settle_ms Time(ms) to wait for no more requests before writing
+      @return True if successful
+      @note The values are output and stored by storeBothVoltageAsync
+      @note The cached copy is unknown until the first store, because the stored values can not be read back
+     */
+    bool setupPersistence(m5::unit::anadig::PersistenceManager& pm, const uint32_t settle_ms = 1000);
+    ///@}
+
 protected:
-    uint16_t voltage_to_raw(const gp8413::Channel channel, const float mv);
+    friend class DACGroup;
+
+    inline uint16_t voltage_to_raw(const gp8413::Channel channel, const float mv) const
+    {
+        const auto idx = m5::stl::to_underlying(channel);
+        return _correction[idx] ? _correction[idx]->to_code(m5::unit::anadig::mv_to_microvoltage(mv))
+                                : _fscale[idx].to_code(mv);
+    }
+    void update_scale();
+    bool write_range_and_voltage(const gp8413::Output range[2], const uint16_t raw[2]);
+    bool write_masked_voltage(const bool mask[2], const uint16_t raw[2]);
     bool write_voltage(const uint8_t reg, const uint8_t* buf, const uint32_t len);
+    // The raw value has been written by the prebuilt frame (DACGroup)
+    inline void written(const gp8413::Channel channel, const uint16_t raw)
+    {
+        _last_raw[m5::stl::to_underlying(channel)] = raw;
+    }
+    bool send_store_command();
+    void update_setpoints();
+    void update_ramp();
+    void update_store();
 
 private:
     gp8413::Output _range[2]{};
+    // Cached on writeOutputRange
+    m5::unit::anadig::CodeScale _scale[2]{};
+    m5::unit::anadig::FloatCodeScale _fscale[2]{};
+    const m5::unit::anadig::DacCorrection* _correction[2]{};
     config_t _cfg{};
+
+    uint16_t _last_raw[2]{}, _stored_raw[2]{}, _pending_raw[2]{};
+    bool _has_stored{}, _has_pending[2]{};
+    gp8413::StoreState _store_state{};
+    types::elapsed_time_t _store_done_at{};
+    uint32_t _store_skipped{};
+    store_callback_t _store_callback{};
+
+    m5::unit::anadig::Ramp _ramp[2]{};
+    m5::unit::anadig::SetpointQueue _setpoints{};
 };
 
 namespace gp8413 {
@@ -15,6 +15,12 @@ using namespace m5::unit::types;
 using namespace m5::unit::mcp4725;
 
 namespace {
+constexpr uint32_t burst_frame_clocks{18};  // 2 bytes + ACK
+constexpr uint32_t fast_frame_clocks{29};   // START + address + 2 bytes + ACK + STOP
+// EEPROM write time typ:25 max:50
+constexpr uint32_t eeprom_first_poll_ms{25};
+constexpr uint32_t eeprom_poll_interval_ms{5};
+constexpr uint32_t eeprom_timeout_ms{60};
 }  // namespace
 
 namespace m5 {
@@ -45,8 +51,139 @@ bool UnitMCP4725::begin()
     return _cfg.using_eeprom_settings ? writeVoltage(_lastValue) : true;
 }
 
+void UnitMCP4725::update(const bool force)
+{
+    update_setpoints();
+    update_ramp();
+    update_dither();
+    update_eeprom(force);
+}
+
+void UnitMCP4725::update_setpoints()
+{
+    if (!_setpoints.empty()) {
+        _setpoints.dispatch(m5::utility::micros(),
+                            [this](const uint8_t, const uint16_t raw) { return writeVoltage(raw); });
+    }
+}
+
+bool UnitMCP4725::rampMicroVoltage(const int32_t uv, const uint32_t rate_mv_per_s, const bool s_curve)
+{
+    if (uv < 0) {
+        return false;
+    }
+    _dithering = false;
+    _ramp.start(raw_to_microvoltage(_lastValue), uv, rate_mv_per_s, s_curve, m5::utility::micros());
+    update_ramp();
+    return true;
+}
+
+void UnitMCP4725::update_ramp()
+{
+    // The position is time-based, so the output catches up after the EEPROM write
+    if (_ramp.active() && !eepromBusy()) {
+        const uint16_t raw = microvoltage_to_raw(_ramp.update(m5::utility::micros()));
+        if (raw != _lastValue) {
+            write_voltage(Command::FastMode, raw);
+        }
+    }
+}
+
+bool UnitMCP4725::ditherMicroVoltage(const int32_t uv, const uint32_t rate_hz)
+{
+    if (uv < 0 || !rate_hz) {
+        return false;
+    }
+    // Up to half of the bus time
+    const uint32_t max_hz = component_config().clock / (fast_frame_clocks * 2);
+    const uint32_t hz     = (rate_hz < max_hz) ? rate_hz : max_hz;
+    if (hz != rate_hz) {
+        M5_LIB_LOGW("Dither rate is limited to %u Hz", hz);
+    }
+    if (!_dithering) {
+        _dither.reset();
+    }
+    _ramp.stop();
+    _dither.setTarget(microvoltage_to_raw_q8(uv), RESOLUTION);
+    _dither_interval = 1000000U / hz;
+    _dither_at       = m5::utility::micros();
+    _dithering       = true;
+    update_dither();
+    return true;
+}
+
+void UnitMCP4725::update_dither()
+{
+    if (!_dithering || eepromBusy()) {
+        return;
+    }
+    const uint32_t now = m5::utility::micros();
+    if ((int32_t)(now - _dither_at) < 0) {
+        return;
+    }
+    _dither_at += _dither_interval;
+    if ((int32_t)(now - _dither_at) >= 0) {
+        _dither_at = now + _dither_interval;  // Late, no catch-up
+    }
+    const uint16_t raw = _dither.next();
+    if (raw != _lastValue) {
+        write_voltage(Command::FastMode, raw);
+    }
+}
+
+void UnitMCP4725::update_eeprom(const bool force)
+{
+    if (_eeprom_state != EEPROMState::Writing) {
+        return;
+    }
+    auto at = m5::utility::millis();
+    if (!force && (int32_t)(at - _eeprom_poll_at) < 0) {
+        return;
+    }
+
+    const bool ready = is_eeprom_ready();
+    if (!ready && at - _eeprom_started_at < eeprom_timeout_ms) {
+        _eeprom_poll_at = at + eeprom_poll_interval_ms;
+        return;
+    }
+    if (!ready) {
+        M5_LIB_LOGW("EEPROM write timed out");
+    }
+    _eeprom_state = ready ? EEPROMState::Idle : EEPROMState::Failed;
+    if (_has_pending) {
+        _has_pending = false;
+        write_voltage(Command::FastMode, _pending_raw);
+    }
+    if (_persistence) {
+        _persistence->complete(ready, static_cast<uint32_t>(at));
+    }
+    if (_eeprom_callback) {
+        _eeprom_callback(*this, ready);
+    }
+}
+
+bool UnitMCP4725::writeVoltageAndEEPROMAsync(const uint16_t raw)
+{
+    if (eepromBusy()) {
+        M5_LIB_LOGD("EEPROM write is in progress");
+        return false;
+    }
+    if (write_voltage(Command::WriteDACAndEEPROM, raw)) {
+        _has_pending       = false;
+        _eeprom_started_at = m5::utility::millis();
+        _eeprom_poll_at    = _eeprom_started_at + eeprom_first_poll_ms;
+        _eeprom_state      = EEPROMState::Writing;
+        return true;
+    }
+    return false;
+}
+
 bool UnitMCP4725::writeVoltageAndEEPROM(const uint16_t raw, const bool blocking)
 {
+    if (eepromBusy()) {
+        M5_LIB_LOGD("EEPROM write is in progress");
+        return false;
+    }
     if (write_voltage(Command::WriteDACAndEEPROM, raw)) {
         bool done{!blocking};
         if (blocking) {
@@ -67,6 +204,13 @@ bool UnitMCP4725::writeVoltageAndEEPROM(const uint16_t raw, const bool blocking)
 
 bool UnitMCP4725::write_voltage(const Command cmd, const uint16_t raw)
 {
+    // Deferred until the EEPROM write is completed
+    if (cmd == Command::FastMode && eepromBusy()) {
+        _pending_raw = raw;
+        _has_pending = true;
+        return true;
+    }
+
     uint8_t buf[3]{};
     uint32_t len = make_buffer(buf, raw, cmd);
     if (writeWithTransaction(buf, len) == m5::hal::error::error_t::OK) {
@@ -76,6 +220,63 @@ bool UnitMCP4725::write_voltage(const Command cmd, const uint16_t raw)
     return false;
 }
 
+bool UnitMCP4725::writeVoltageBurst(const uint16_t* raw, const size_t num, const uint8_t repeat)
+{
+    if (!raw || !num || !repeat) {
+        return false;
+    }
+    if (eepromBusy()) {
+        M5_LIB_LOGD("EEPROM write is in progress");
+        return false;
+    }
+
+    uint8_t buf[MAX_BURST_FRAMES * 2]{};
+    uint32_t len{};
+    for (size_t i = 0; i < num; ++i) {
+        const uint16_t v = raw[i] & RESOLUTION;
+        for (uint8_t r = 0; r < repeat; ++r) {
+            len += make_buffer(buf + len, v, Command::FastMode);
+            if (len >= sizeof(buf)) {
+                if (writeWithTransaction(buf, len) != m5::hal::error::error_t::OK) {
+                    return false;
+                }
+                _lastValue = v;  // The last frame of the transaction
+                len        = 0;
+            }
+        }
+    }
+    if (len) {
+        if (writeWithTransaction(buf, len) != m5::hal::error::error_t::OK) {
+            return false;
+        }
+        _lastValue = raw[num - 1] & RESOLUTION;
+    }
+    return true;
+}
+
+uint8_t UnitMCP4725::burstRepeat(const uint32_t interval_us)
+{
+    const uint64_t clocks = (static_cast<uint64_t>(interval_us) * component_config().clock + 500000U) / 1000000U;
+    const uint64_t rep    = (clocks + burst_frame_clocks / 2) / burst_frame_clocks;
+    return static_cast<uint8_t>(rep < 1 ? 1 : (rep > 255 ? 255 : rep));
+}
+
+bool UnitMCP4725::setupPersistence(m5::unit::anadig::PersistenceManager& pm, const uint32_t settle_ms)
+{
+    if (!pm.begin(
+            1, [this](const uint16_t* values, const uint8_t) { return writeVoltageAndEEPROMAsync(values[0]); },
+            [this]() { return eepromBusy(); }, settle_ms)) {
+        return false;
+    }
+    _persistence = &pm;
+    PowerDown pd{};
+    uint16_t raw{};
+    if (readEEPROM(pd, raw)) {
+        pm.setStored(&raw);
+    }
+    return true;
+}
+
 bool UnitMCP4725::generalReset()
 {
     uint8_t cmd{0x06};  // reset command
@@ -144,6 +345,14 @@ uint32_t UnitMCP4725::make_buffer(uint8_t buf[3], const uint16_t raw, const Comm
     return len;
 }
 
+void UnitMCP4725::update_scale()
+{
+    if (_cfg.supply_voltage > 0.0f) {
+        _scale = m5::unit::anadig::CodeScale(RESOLUTION, static_cast<uint32_t>(_cfg.supply_voltage * 1000.f),
+                                             static_cast<uint32_t>(MAXIMUM_VOLTAGE * 1000.f));
+    }
+}
+
 bool UnitMCP4725::read_status(uint8_t rbuf[5])
 {
     return rbuf && (readWithTransaction(rbuf, 5) == m5::hal::error::error_t::OK);
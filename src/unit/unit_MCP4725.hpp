@@ -10,10 +10,19 @@
 #ifndef M5_UNIT_ANADIG_UNIT_MCP4725_HPP
 #define M5_UNIT_ANADIG_UNIT_MCP4725_HPP
 #include <M5UnitComponent.hpp>
+#include "../utility/fixed_point.hpp"
+#include "../utility/persistence.hpp"
+#include "../utility/ramp.hpp"
+#include "../utility/dither.hpp"
+#include "../utility/linearity.hpp"
+#include "../utility/setpoint_queue.hpp"
+#include <functional>
 
 namespace m5 {
 namespace unit {
 
+class DACGroup;
+
 /*!
   @namespace mcp4725
   @brief For MCP4725
@@ -27,6 +36,16 @@ enum class PowerDown : uint8_t {
     OHM_500K   //!< 500k ohm resistor to ground
 };
 
+/*!
+  @enum EEPROMState
+  @brief State of the non-blocking EEPROM write
+ */
+enum class EEPROMState : uint8_t {
+    Idle,     //!< Not writing (The last write has been completed)
+    Writing,  //!< Writing in progress
+    Failed,   //!< The last write was not completed in time
+};
+
 }  // namespace mcp4725
 
 /*!
@@ -40,16 +59,22 @@ public:
     static constexpr uint16_t RESOLUTION{0x0FFF};    // 12bits
     static constexpr float MAXIMUM_VOLTAGE{3300.f};  // mV
 
+    /*!
+      @brief Callback on completion of the non-blocking EEPROM write
+      @param unit This unit
+      @param success True if completed, false if timed out
+     */
+    using eeprom_callback_t = std::function<void(UnitMCP4725& unit, const bool success)>;
+
     //! @brief Raw value to voltage(mV)
     static inline float raw_to_voltage(const uint16_t raw, const float supply_voltage = 5000.f)
     {
-        return static_cast<float>(raw) * supply_voltage / RESOLUTION;
+        return m5::unit::anadig::dac_code_to_voltage(raw, supply_voltage, RESOLUTION);
     }
     //! @brief Voltage(mV) to raw value
     static inline uint16_t voltage_to_raw(const float mv, const float supply_voltage = 5000.f)
     {
-        float val = std::fmin(std::fmax(mv, 0.0f), MAXIMUM_VOLTAGE);
-        return static_cast<uint16_t>((val / supply_voltage) * RESOLUTION);
+        return m5::unit::anadig::dac_voltage_to_code(mv, MAXIMUM_VOLTAGE, supply_voltage, RESOLUTION);
     }
 
     /*!
@@ -68,12 +93,14 @@ public:
         auto ccfg  = component_config();
         ccfg.clock = 400 * 1000U;
         component_config(ccfg);
+        update_scale();
     }
     virtual ~UnitMCP4725()
     {
     }
 
     virtual bool begin() override;
+    virtual void update(const bool force = false) override;
 
     ///@name Settings for begin
     ///@{
@@ -86,6 +113,54 @@ public:
     inline void config(const config_t& cfg)
     {
         _cfg = cfg;
+        update_scale();
+    }
+    ///@}
+
+    ///@name Integer conversion (without floating point operations)
+    ///@{
+    //! @brief Raw value to voltage(uV) using supply voltage of the configuration (or the correction)
+    inline int32_t raw_to_microvoltage(const uint16_t raw) const
+    {
+        return _correction ? _correction->to_microvoltage(raw) : _scale.to_microvoltage(raw);
+    }
+    //! @brief Voltage(uV) to raw value using supply voltage of the configuration (or the correction)
+    inline uint16_t microvoltage_to_raw(const int32_t uv) const
+    {
+        return _correction ? _correction->to_code(uv) : _scale.to_code(uv);
+    }
+    //! @brief Voltage(uV) to raw value in Q24.8 (With the fraction below 1 code, for dithering)
+    inline uint32_t microvoltage_to_raw_q8(const int32_t uv) const
+    {
+        return _correction ? _correction->to_code_q8(uv) : _scale.to_code_q8(uv);
+    }
+    /*!
+      @brief Gets the nominal scale between voltage(uV) and raw value
+      @note The correction is not applied. Pass microvoltage_to_raw as the code function of
+      anadig::WaveformGenerator::build for the corrected output
+     */
+    inline const m5::unit::anadig::CodeScale& scale() const
+    {
+        return _scale;
+    }
+    ///@}
+
+    ///@note Applied to the voltage conversions of the unit (Float and uV), not to the static functions
+    ///@name Linearity correction
+    ///@{
+    /*!
+      @brief Set the correction (e.g. built by LoopbackSweep)
+      @param correction Correction, or nullptr to clear
+      @warning The correction must outlive the use by this unit
+     */
+    inline void setCorrection(const m5::unit::anadig::DacCorrection* correction)
+    {
+        _correction = (correction && correction->valid()) ? correction : nullptr;
+    }
+    //! @brief Gets the correction (nullptr if not set)
+    inline const m5::unit::anadig::DacCorrection* correction() const
+    {
+        return _correction;
     }
     ///@}
 
@@ -126,7 +201,7 @@ public:
     template <typename T, typename std::enable_if<std::is_floating_point<T>::value, std::nullptr_t>::type = nullptr>
     inline bool writeVoltage(const T mv)
     {
-        return (mv >= 0.0f) && writeVoltage(voltage_to_raw((float)mv, _cfg.supply_voltage));
+        return (mv >= 0.0f) && writeVoltage(mv_to_raw((float)mv));
     }
     /*!
        @brief Output the voltage
@@ -145,7 +220,143 @@ public:
     {
         return writeVoltage(static_cast<uint16_t>(raw & RESOLUTION));
     }
+    /*!
+       @brief Output the voltage without floating point operations
+       @param uv Output voltage(uV)
+       @return True if successful
+       @Note If exceeding the range, it will be kept within the range
+      */
+    inline bool writeMicroVoltage(const int32_t uv)
+    {
+        return (uv >= 0) && writeVoltage(microvoltage_to_raw(uv));
+    }
+
+    ///@}
+
+    ///@note Consecutive fast mode frames are sent without re-sending the address
+    ///@name Burst output
+    ///@{
+    /*!
+      @brief Maximum number of frames in a transaction
+      @note Limited by the I2C buffer of the Arduino Wire (128 bytes)
+     */
+    static constexpr size_t MAX_BURST_FRAMES{63};
+    /*!
+      @brief Output the raw values consecutively
+      @param raw Raw values
+      @param num Number of values
+      @param repeat Number of frames for each value (Pacing by the bus clock)
+      @return True if successful
+      @note Split into transactions every MAX_BURST_FRAMES frames
+      @note Fails while the non-blocking EEPROM write is in progress
+      @note Each value is output at the end of its frame, every 18 SCL clocks
+     */
+    bool writeVoltageBurst(const uint16_t* raw, const size_t num, const uint8_t repeat = 1);
+    /*!
+      @brief Number of frames per value for the interval
+      @param interval_us Interval(us) of each value
+      @return repeat for writeVoltageBurst (At least 1)
+      @note Calculated from the I2C clock of the component configuration
+     */
+    uint8_t burstRepeat(const uint32_t interval_us);
+    ///@}
 
+    ///@note The setpoints are issued in update() (Call it from loop() or a dedicated task)
+    ///@note The queue is empty until allocated by setpointQueue().begin()
+    ///@name Setpoint queue
+    ///@{
+    //! @brief Gets the setpoint queue (Channel is ignored)
+    inline m5::unit::anadig::SetpointQueue& setpointQueue()
+    {
+        return _setpoints;
+    }
+    /*!
+      @brief Push the setpoint
+      @param at_us Deadline(us) of m5::utility::micros()
+      @param raw Output voltage raw value
+      @return True if successful
+     */
+    inline bool pushSetpoint(const uint32_t at_us, const uint16_t raw)
+    {
+        return _setpoints.push(at_us, 0, raw);
+    }
+    ///@}
+
+    ///@note The ramp is advanced in update() and the output is written only when the code changes
+    ///@note Outputs by other functions during the ramp are overwritten
+    ///@name Ramp
+    ///@{
+    /*!
+      @brief Start the ramp from the current output to the target
+      @param mv Target voltage(mV)
+      @param rate_mv_per_s Slew rate(mV/s)
+      @param s_curve Use S-curve if true
+      @return True if successful
+     */
+    template <typename T, typename std::enable_if<std::is_floating_point<T>::value, std::nullptr_t>::type = nullptr>
+    inline bool rampVoltage(const T mv, const uint32_t rate_mv_per_s, const bool s_curve = false)
+    {
+        return (mv >= 0.0f) && rampMicroVoltage(static_cast<int32_t>(mv * 1000), rate_mv_per_s, s_curve);
+    }
+    /*!
+      @brief Start the ramp from the current output to the target without floating point operations
+      @param uv Target voltage(uV)
+      @param rate_mv_per_s Slew rate(mV/s)
+      @param s_curve Use S-curve if true
+      @return True if successful
+     */
+    bool rampMicroVoltage(const int32_t uv, const uint32_t rate_mv_per_s, const bool s_curve = false);
+    //! @brief Is ramping?
+    inline bool ramping() const
+    {
+        return _ramp.active();
+    }
+    //! @brief Stop the ramp at the current output
+    inline void stopRamp()
+    {
+        _ramp.stop();
+    }
+    ///@}
+
+    ///@note Alternates adjacent codes in update() so that the average after a low-pass filter is below 1 LSB
+    ///@note Writes are paced by the rate and limited to half of the bus time (No catch-up if update() is late)
+    ///@note Starting the ramp stops dithering, and vice versa
+    ///@name Dithering
+    ///@{
+    /*!
+      @brief Start dithering
+      @param mv Output voltage(mV)
+      @param rate_hz Dither rate(Hz)
+      @return True if successful
+     */
+    template <typename T, typename std::enable_if<std::is_floating_point<T>::value, std::nullptr_t>::type = nullptr>
+    inline bool ditherVoltage(const T mv, const uint32_t rate_hz)
+    {
+        return (mv >= 0.0f) && ditherMicroVoltage(static_cast<int32_t>(mv * 1000), rate_hz);
+    }
+    /*!
+      @brief Start dithering without floating point operations
+      @param uv Output voltage(uV)
+      @param rate_hz Dither rate(Hz)
+      @return True if successful
+      @note Updating the target while dithering keeps the accumulated error
+     */
+    bool ditherMicroVoltage(const int32_t uv, const uint32_t rate_hz);
+    //! @brief Is dithering?
+    inline bool dithering() const
+    {
+        return _dithering;
+    }
+    //! @brief Gets the actual dither rate(Hz)
+    inline uint32_t ditherRate() const
+    {
+        return _dither_interval ? 1000000U / _dither_interval : 0;
+    }
+    //! @brief Stop dithering at the current output
+    inline void stopDither()
+    {
+        _dithering = false;
+    }
     ///@}
 
     //! @note After a reset, the device uploads the contents of the EEPROM to the DAC register
@@ -161,7 +372,7 @@ public:
     template <typename T, typename std::enable_if<std::is_floating_point<T>::value, std::nullptr_t>::type = nullptr>
     inline bool writeVoltageAndEEPROM(const T mv, const bool blocking = true)
     {
-        return (mv >= 0.0f) && writeVoltageAndEEPROM(voltage_to_raw((float)mv, _cfg.supply_voltage), blocking);
+        return (mv >= 0.0f) && writeVoltageAndEEPROM(mv_to_raw((float)mv), blocking);
     }
 
     /*!
@@ -179,8 +390,73 @@ public:
     {
         return writeVoltageAndEEPROM(static_cast<uint16_t>(raw & RESOLUTION), blocking);
     }
+    /*!
+      @brief Write to DAC register and EEPROM without floating point operations
+      @param uv Output voltage(uV)
+      @param blocking Wait until EEPROM write is complete if true
+      @return True if successful
+      @Note If exceeding the range, it will be kept within the range
+     */
+    inline bool writeMicroVoltageAndEEPROM(const int32_t uv, const bool blocking = true)
+    {
+        return (uv >= 0) && writeVoltageAndEEPROM(microvoltage_to_raw(uv), blocking);
+    }
+    ///@}
+
+    ///@note The EEPROM write is started and its completion is polled in update()
+    ///@note While writing, outputs by fast mode are deferred and the last one is applied on completion
+    ///@name Write to DAC register and EEPROM without blocking
+    ///@{
+    /*!
+      @brief Start writing to DAC register and EEPROM
+      @param raw Output raw value
+      @return True if started
+      @note Fails if the previous write is in progress
+     */
+    bool writeVoltageAndEEPROMAsync(const uint16_t raw);
+    /*!
+      @brief Start writing to DAC register and EEPROM
+      @param mv Output voltage(mV)
+      @return True if started
+     */
+    template <typename T, typename std::enable_if<std::is_floating_point<T>::value, std::nullptr_t>::type = nullptr>
+    inline bool writeVoltageAndEEPROMAsync(const T mv)
+    {
+        return (mv >= 0.0f) && writeVoltageAndEEPROMAsync(mv_to_raw((float)mv));
+    }
+    //! @brief Start writing to DAC register and EEPROM without floating point operations
+    inline bool writeMicroVoltageAndEEPROMAsync(const int32_t uv)
+    {
+        return (uv >= 0) && writeVoltageAndEEPROMAsync(microvoltage_to_raw(uv));
+    }
+    //! @brief Gets the state of the non-blocking EEPROM write
+    inline mcp4725::EEPROMState eepromState() const
+    {
+        return _eeprom_state;
+    }
+    //! @brief Is the EEPROM write in progress?
+    inline bool eepromBusy() const
+    {
+        return _eeprom_state == mcp4725::EEPROMState::Writing;
+    }
+    //! @brief Set the callback called in update() on completion
+    inline void setEEPROMCallback(eeprom_callback_t cb)
+    {
+        _eeprom_callback = cb;
+    }
     ///@}
 
+    /*!
+      @brief Set up the persistence manager for this unit
+      @param pm Manager
+      @param settle_ms Time(ms) to wait for no more requests before writing
+      @return True if successful
+      @note The cached copy is read from the EEPROM, and values are written by writeVoltageAndEEPROMAsync
+      @note The manager is notified of the completion in update(), and retries if the EEPROM write timed out.
+      The manager must outlive this unit or be replaced by another setupPersistence
+     */
+    bool setupPersistence(m5::unit::anadig::PersistenceManager& pm, const uint32_t settle_ms = 1000);
+
     /*!
       @brief General reset
       @details Reset using I2C general call
@@ -206,6 +482,8 @@ public:
     bool readEEPROM(mcp4725::PowerDown& pd, uint16_t& raw);
 
 protected:
+    friend class DACGroup;
+
     enum class Command : uint8_t {
         FastMode,           // 2bytes [0:0:PD1:PD0:D11:D10:D9:D8] [D7... D0]
         WriteDAC,           // 3bytes [0:1:0:X:X:PD1:PD0:X]       [D11...D4] [D3:D2:D1:D0:X:X:X:X]
@@ -213,14 +491,44 @@ protected:
     };
 
     bool write_voltage(const Command cmd, const uint16_t raw);
+    // The raw value has been written by the prebuilt frame (DACGroup)
+    inline void written(const uint16_t raw)
+    {
+        _lastValue = raw;
+    }
     bool is_eeprom_ready();
     uint32_t make_buffer(uint8_t buf[3], const uint16_t raw, const Command cmd);
     bool read_status(uint8_t rbuf[5]);
+    void update_scale();
+    inline uint16_t mv_to_raw(const float mv) const
+    {
+        return _correction ? _correction->to_code(m5::unit::anadig::mv_to_microvoltage(mv))
+                           : voltage_to_raw(mv, _cfg.supply_voltage);
+    }
+    void update_setpoints();
+    void update_ramp();
+    void update_dither();
+    void update_eeprom(const bool force);
 
 private:
     mcp4725::PowerDown _powerDown{};
     uint16_t _lastValue{};
     config_t _cfg{};
+    m5::unit::anadig::CodeScale _scale{};
+    const m5::unit::anadig::DacCorrection* _correction{};
+
+    mcp4725::EEPROMState _eeprom_state{};
+    types::elapsed_time_t _eeprom_started_at{}, _eeprom_poll_at{};
+    bool _has_pending{};
+    uint16_t _pending_raw{};
+    eeprom_callback_t _eeprom_callback{};
+    m5::unit::anadig::PersistenceManager* _persistence{};
+
+    m5::unit::anadig::Ramp _ramp{};
+    m5::unit::anadig::SigmaDelta _dither{};
+    bool _dithering{};
+    uint32_t _dither_interval{}, _dither_at{};
+    m5::unit::anadig::SetpointQueue _setpoints{};
 };
 
 }  // namespace unit
@@ -0,0 +1,140 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file calibration.cpp
+  @brief Two-point offset/gain calibration record of the ADC
+*/
+#include "calibration.hpp"
+#include "telemetry.hpp"
+#include <limits>
+
+namespace {
+
+constexpr uint8_t MAGIC[2]{'A', 'C'};
+constexpr size_t HEADER_SIZE{8};  // magic + version + num + id
+
+void put_u32(uint8_t* p, const uint32_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = (v >> 24) & 0xFF;
+}
+
+uint32_t get_u32(const uint8_t* p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
+
+}  // namespace
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+constexpr uint8_t AdcCalibration::NUM_PGA;
+constexpr uint8_t AdcCalibration::VERSION;
+constexpr size_t AdcCalibration::SERIALIZED_SIZE;
+
+static_assert(AdcCalibration::SERIALIZED_SIZE == HEADER_SIZE + AdcCalibration::NUM_PGA * 8 + telemetry::CRC_SIZE,
+              "Invalid size");
+
+bool two_point_correction(const int32_t measured1_uv, const int32_t actual1_uv, const int32_t measured2_uv,
+                          const int32_t actual2_uv, GainOffset& out)
+{
+    const int64_t dm = static_cast<int64_t>(measured2_uv) - measured1_uv;
+    const int64_t da = static_cast<int64_t>(actual2_uv) - actual1_uv;
+    if (!dm) {
+        return false;
+    }
+    // Rounded to nearest
+    const int64_t num  = da * 65536;
+    const int64_t half = (dm < 0 ? -dm : dm) / 2;
+    const int64_t gain = (num < 0 ? num - half : num + half) / dm;
+    if (gain <= 0 || gain > std::numeric_limits<int32_t>::max()) {
+        return false;
+    }
+    GainOffset go{};
+    go.gain_q16 = static_cast<int32_t>(gain);
+    // Split the rounding error of the gain between both references
+    const int64_t r = static_cast<int64_t>(actual1_uv) - go.apply(measured1_uv) + actual2_uv - go.apply(measured2_uv);
+    go.offset_uv    = static_cast<int32_t>((r < 0 ? r - 1 : r + 1) / 2);
+    out             = go;
+    return true;
+}
+
+bool AdcCalibration::identity() const
+{
+    for (auto&& c : pga) {
+        if (!c.identity()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool AdcCalibration::valid() const
+{
+    for (auto&& c : pga) {
+        if (!c.valid()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t AdcCalibration::serialize(uint8_t* buf, const size_t len) const
+{
+    if (!buf || len < SERIALIZED_SIZE) {
+        return 0;
+    }
+    uint8_t* p = buf;
+    *p++       = MAGIC[0];
+    *p++       = MAGIC[1];
+    *p++       = VERSION;
+    *p++       = NUM_PGA;
+    put_u32(p, id);
+    p += 4;
+    for (auto&& c : pga) {
+        put_u32(p, static_cast<uint32_t>(c.gain_q16));
+        put_u32(p + 4, static_cast<uint32_t>(c.offset_uv));
+        p += 8;
+    }
+    const uint16_t crc = telemetry::crc16(buf, p - buf);
+    *p++               = crc & 0xFF;
+    *p++               = crc >> 8;
+    return p - buf;
+}
+
+bool AdcCalibration::deserialize(const uint8_t* buf, const size_t len)
+{
+    if (!buf || len < SERIALIZED_SIZE || buf[0] != MAGIC[0] || buf[1] != MAGIC[1] || buf[2] != VERSION ||
+        buf[3] != NUM_PGA) {
+        return false;
+    }
+    const size_t body = SERIALIZED_SIZE - telemetry::CRC_SIZE;
+    if (telemetry::crc16(buf, body) != (buf[body] | (buf[body + 1] << 8))) {
+        return false;
+    }
+    AdcCalibration cal{};
+    cal.id           = get_u32(buf + 4);
+    const uint8_t* p = buf + HEADER_SIZE;
+    for (auto&& c : cal.pga) {
+        c.gain_q16  = static_cast<int32_t>(get_u32(p));
+        c.offset_uv = static_cast<int32_t>(get_u32(p + 4));
+        if (!c.valid()) {
+            return false;
+        }
+        p += 8;
+    }
+    *this = cal;
+    return true;
+}
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
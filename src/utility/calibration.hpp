@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file calibration.hpp
+  @brief Two-point offset/gain calibration record of the ADC
+  @details Host buildable, no dependency on M5UnitUnified
+
+  Serialized record (Multi-byte values are little endian)
+  @verbatim
+  Record := 'A' 'C' version(u8) num(u8) id(u32) (gain_q16(i32) offset_uv(i32)){num} crc16(u16)
+  @endverbatim
+  crc16 is CRC-16/CCITT-FALSE of the record without crc16
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_CALIBRATION_HPP
+#define M5_UNIT_ANADIG_UTILITY_CALIBRATION_HPP
+
+#include "linearity.hpp"
+#include <cstdint>
+#include <cstddef>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+/*!
+  @brief Calculate the correction from two reference points
+  @param measured1_uv Measured voltage(uV) of the first reference (Without correction)
+  @param actual1_uv Actual voltage(uV) of the first reference
+  @param measured2_uv Measured voltage(uV) of the second reference (Without correction)
+  @param actual2_uv Actual voltage(uV) of the second reference
+  @param[out] out Correction
+  @return True if successful
+  @note The references should be far apart (e.g. near zero and near full scale)
+ */
+bool two_point_correction(const int32_t measured1_uv, const int32_t actual1_uv, const int32_t measured2_uv,
+                          const int32_t actual2_uv, GainOffset& out);
+
+/*!
+  @struct AdcCalibration
+  @brief Calibration record of a board
+  @details Gain and offset for each PGA setting, because the gain error differs for each PGA
+ */
+struct AdcCalibration {
+    static constexpr uint8_t NUM_PGA{4};          //!< Number of PGA settings
+    static constexpr uint8_t VERSION{0x01};       //!< Record version
+    static constexpr size_t SERIALIZED_SIZE{42};  //!< Size of the serialized record
+
+    uint32_t id{};              //!< Identifier of the board (User defined, e.g. serial number)
+    GainOffset pga[NUM_PGA]{};  //!< Correction for each PGA (Index is the PGA value)
+
+    //! @brief Is identity for all PGA?
+    bool identity() const;
+    //! @brief Is valid for all PGA?
+    bool valid() const;
+    //! @brief Reset to identity
+    inline void clear()
+    {
+        *this = AdcCalibration{};
+    }
+
+    /*!
+      @brief Serialize the record
+      @param[out] buf Output buffer
+      @param len Size of the buffer (At least SERIALIZED_SIZE)
+      @return Serialized size, 0 if failed
+     */
+    size_t serialize(uint8_t* buf, const size_t len) const;
+    /*!
+      @brief Deserialize the record
+      @param buf Serialized record
+      @param len Size of the record
+      @return True if successful
+      @note Not changed if failed (Broken, different version, etc.)
+     */
+    bool deserialize(const uint8_t* buf, const size_t len);
+};
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file capture.cpp
+  @brief Oscilloscope-style triggered capture with pre/post-trigger buffering
+*/
+#include "capture.hpp"
+#include <algorithm>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+bool Capture::config(const CaptureConfig& cfg)
+{
+    _state  = State::Idle;
+    _frozen = -1;
+    if (!cfg.post) {
+        return false;
+    }
+
+    uint32_t cap = (uint32_t)cfg.pre + cfg.post;
+    if (cap != _capacity) {
+        _capacity = 0;
+        for (auto&& b : _bank) {
+            b.reset(new int16_t[cap]);
+            if (!b) {
+                return false;
+            }
+        }
+        _capacity = cap;
+    }
+    _cfg   = cfg;
+    _count = _missed = 0;
+    return true;
+}
+
+void Capture::arm()
+{
+    if (!_capacity) {
+        return;
+    }
+    _wpos     = _filled = 0;
+    _has_prev = _sw_trigger = false;
+    _state    = State::Armed;
+}
+
+bool Capture::push(const int16_t v)
+{
+    if (_state == State::Idle) {
+        return false;
+    }
+
+    _bank[_active][_wpos] = v;
+    _wpos                 = (_wpos + 1) % _capacity;
+    _filled += (_filled < _capacity) ? 1 : 0;
+
+    bool frozen{};
+    if (_state == State::Armed) {
+        if (_sw_trigger || is_triggered(v)) {
+            if (available()) {
+                ++_missed;
+            } else {
+                _pre_avail   = std::min<uint32_t>(_filled - 1, _cfg.pre);
+                _post_remain = _cfg.post - 1;
+                _state       = State::Triggered;
+            }
+        }
+        _sw_trigger = false;
+    } else if (_post_remain) {
+        --_post_remain;
+    }
+    if (_state == State::Triggered && !_post_remain) {
+        freeze();
+        frozen = true;
+    }
+    _prev     = v;
+    _has_prev = true;
+    return frozen;
+}
+
+bool Capture::is_triggered(const int16_t v) const
+{
+    const int16_t lv = _cfg.level;
+    const bool rising{_has_prev && _prev < lv && v >= lv};
+    const bool falling{_has_prev && _prev > lv && v <= lv};
+
+    switch (_cfg.trigger) {
+        case Trigger::Rising:
+            return rising;
+        case Trigger::Falling:
+            return falling;
+        case Trigger::Edge:
+            return rising || falling;
+        case Trigger::Above:
+            return v >= lv;
+        case Trigger::Below:
+            return v <= lv;
+        default:
+            return false;
+    }
+}
+
+void Capture::freeze()
+{
+    int16_t* p = _bank[_active].get();
+    if (_filled == _capacity && _wpos) {
+        std::rotate(p, p + _wpos, p + _capacity);  // Oldest to the front
+    }
+    _win_size    = _pre_avail + _cfg.post;
+    _win_offset  = _filled - _win_size;
+    _win_trigger = _pre_avail;
+
+    _frozen = _active;
+    _active ^= 1;
+    ++_count;
+
+    _wpos  = _filled = 0;
+    _state = _cfg.auto_rearm ? State::Armed : State::Idle;
+}
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
@@ -0,0 +1,166 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file capture.hpp
+  @brief Oscilloscope-style triggered capture with pre/post-trigger buffering
+  @details Host buildable, no dependency on M5UnitUnified
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_CAPTURE_HPP
+#define M5_UNIT_ANADIG_UTILITY_CAPTURE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+/*!
+  @enum Trigger
+  @brief Trigger condition
+ */
+enum class Trigger : uint8_t {
+    Software,  //!< Only by Capture::trigger()
+    Rising,    //!< Crossing the level upward
+    Falling,   //!< Crossing the level downward
+    Edge,      //!< Rising or Falling
+    Above,     //!< Value >= level
+    Below,     //!< Value <= level
+};
+
+/*!
+  @struct CaptureConfig
+  @brief Capture settings
+ */
+struct CaptureConfig {
+    Trigger trigger{Trigger::Rising};  //!< Trigger condition
+    int16_t level{};                   //!< Trigger level (Raw value)
+    uint16_t pre{64};                  //!< Number of pre-trigger samples
+    uint16_t post{64};                 //!< Number of post-trigger samples (Including the trigger sample)
+    bool auto_rearm{true};             //!< Keep capturing into the other bank after a window is frozen
+};
+
+/*!
+  @class Capture
+  @brief Triggered capture into two banks
+  @details The active bank runs as a ring buffer while armed.
+  When the trigger condition is met and post samples are collected, the window is frozen
+  (linearized in place) and writing continues into the other bank.
+  The frozen window stays valid until release()
+  @note Triggers while a frozen window is not released are counted as missed
+ */
+class Capture {
+public:
+    Capture() = default;
+
+    /*!
+      @brief Set the settings and allocate banks
+      @return True if successful
+      @note Disarmed and any frozen window is discarded
+     */
+    bool config(const CaptureConfig& cfg);
+    //! @brief Gets the settings
+    inline const CaptureConfig& config() const
+    {
+        return _cfg;
+    }
+
+    ///@name State
+    ///@{
+    //! @brief Start capturing into the active bank
+    void arm();
+    //! @brief Stop capturing
+    inline void disarm()
+    {
+        _state = State::Idle;
+    }
+    //! @brief Is capturing?
+    inline bool armed() const
+    {
+        return _state != State::Idle;
+    }
+    //! @brief Triggered and collecting post-trigger samples?
+    inline bool triggered() const
+    {
+        return _state == State::Triggered;
+    }
+    //! @brief Request the trigger on the next sample
+    inline void trigger()
+    {
+        _sw_trigger = armed();
+    }
+    //! @brief Number of frozen windows
+    inline uint32_t count() const
+    {
+        return _count;
+    }
+    //! @brief Number of triggers ignored because the frozen window was not released
+    inline uint32_t missed() const
+    {
+        return _missed;
+    }
+    ///@}
+
+    /*!
+      @brief Push the sample
+      @param v Raw value
+      @return True if a window has been frozen by this sample
+     */
+    bool push(const int16_t v);
+
+    ///@name Frozen window
+    ///@{
+    //! @brief Is the frozen window available?
+    inline bool available() const
+    {
+        return _frozen >= 0;
+    }
+    //! @brief Gets the pointer of the frozen window (nullptr if not available)
+    inline const int16_t* data() const
+    {
+        return available() ? _bank[_frozen].get() + _win_offset : nullptr;
+    }
+    //! @brief Gets the number of samples of the frozen window
+    inline size_t size() const
+    {
+        return available() ? _win_size : 0;
+    }
+    //! @brief Gets the index of the trigger sample in the frozen window
+    inline size_t triggerIndex() const
+    {
+        return _win_trigger;
+    }
+    //! @brief Release the frozen window
+    inline void release()
+    {
+        _frozen = -1;
+    }
+    ///@}
+
+private:
+    enum class State : uint8_t { Idle, Armed, Triggered };
+
+    bool is_triggered(const int16_t v) const;
+    void freeze();
+
+    CaptureConfig _cfg{};
+    std::unique_ptr<int16_t[]> _bank[2]{};
+    uint32_t _capacity{};
+    State _state{State::Idle};
+    uint8_t _active{};
+    int8_t _frozen{-1};
+    bool _sw_trigger{}, _has_prev{};
+    int16_t _prev{};
+    uint32_t _wpos{}, _filled{}, _pre_avail{}, _post_remain{};
+    size_t _win_offset{}, _win_size{}, _win_trigger{};
+    uint32_t _count{}, _missed{};
+};
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
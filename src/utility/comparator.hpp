@@ -0,0 +1,150 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file comparator.hpp
+  @brief Threshold/window comparator with hysteresis and debounce
+  @details Host buildable, no dependency on M5UnitUnified
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_COMPARATOR_HPP
+#define M5_UNIT_ANADIG_UTILITY_COMPARATOR_HPP
+
+#include <cstdint>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+/*!
+  @namespace comparator
+  @brief State and event bits of the Comparator
+ */
+namespace comparator {
+///@name State bits
+///@{
+constexpr uint8_t STATE_LOW{0x01};     //!< Below the low threshold
+constexpr uint8_t STATE_HIGH{0x02};    //!< Above the high threshold
+constexpr uint8_t STATE_INSIDE{0x04};  //!< Inside the window (Both thresholds enabled)
+///@}
+///@name Event bits
+///@{
+constexpr uint8_t EVENT_ENTER_LOW{0x01};     //!< Fell below the low threshold
+constexpr uint8_t EVENT_LEAVE_LOW{0x02};     //!< Recovered from the low threshold
+constexpr uint8_t EVENT_ENTER_HIGH{0x04};    //!< Rose above the high threshold
+constexpr uint8_t EVENT_LEAVE_HIGH{0x08};    //!< Recovered from the high threshold
+constexpr uint8_t EVENT_ENTER_WINDOW{0x10};  //!< Entered the window
+constexpr uint8_t EVENT_LEAVE_WINDOW{0x20};  //!< Left the window
+///@}
+}  // namespace comparator
+
+/*!
+  @struct Threshold
+  @brief Comparator settings
+  @details All values are raw codes
+ */
+struct Threshold {
+    bool enable_low{};      //!< Enable the low threshold
+    bool enable_high{};     //!< Enable the high threshold
+    int16_t low{};          //!< Enter low state if value <= low
+    int16_t high{};         //!< Enter high state if value >= high
+    uint16_t hysteresis{};  //!< Leave low state if value > low + hysteresis, high state if value < high - hysteresis
+    uint8_t debounce{1};    //!< Number of consecutive samples required to change state
+};
+
+/*!
+  @class Comparator
+  @brief Threshold/window comparator for raw codes
+  @details Both thresholds enabled works as window comparator
+ */
+class Comparator {
+public:
+    Comparator() = default;
+    explicit Comparator(const Threshold& th)
+    {
+        config(th);
+    }
+
+    //! @brief Gets the settings
+    inline const Threshold& config() const
+    {
+        return _th;
+    }
+    //! @brief Set the settings and reset state
+    void config(const Threshold& th)
+    {
+        _th          = th;
+        _th.debounce = th.debounce ? th.debounce : 1;
+        reset();
+    }
+    //! @brief Reset state
+    void reset()
+    {
+        _state   = (_th.enable_low && _th.enable_high) ? comparator::STATE_INSIDE : 0;
+        _cnt_low = _cnt_high = 0;
+    }
+
+    //! @brief Any threshold enabled?
+    inline bool enabled() const
+    {
+        return _th.enable_low || _th.enable_high;
+    }
+    //! @brief Gets the current state bits
+    inline uint8_t state() const
+    {
+        return _state;
+    }
+
+    /*!
+      @brief Evaluate the value
+      @param v Raw code
+      @return Event bits occurred by this value (0 if no event)
+     */
+    uint8_t evaluate(const int16_t v)
+    {
+        using namespace comparator;
+        uint8_t ev{};
+        if (_th.enable_low) {
+            const bool in = _state & STATE_LOW;
+            const bool cond =
+                in ? (static_cast<int32_t>(v) > static_cast<int32_t>(_th.low) + _th.hysteresis) : (v <= _th.low);
+            _cnt_low = cond ? _cnt_low + 1 : 0;
+            if (_cnt_low >= _th.debounce) {
+                _state ^= STATE_LOW;
+                ev |= in ? EVENT_LEAVE_LOW : EVENT_ENTER_LOW;
+                _cnt_low = 0;
+            }
+        }
+        if (_th.enable_high) {
+            const bool in = _state & STATE_HIGH;
+            const bool cond =
+                in ? (static_cast<int32_t>(v) < static_cast<int32_t>(_th.high) - _th.hysteresis) : (v >= _th.high);
+            _cnt_high = cond ? _cnt_high + 1 : 0;
+            if (_cnt_high >= _th.debounce) {
+                _state ^= STATE_HIGH;
+                ev |= in ? EVENT_LEAVE_HIGH : EVENT_ENTER_HIGH;
+                _cnt_high = 0;
+            }
+        }
+        if (ev && _th.enable_low && _th.enable_high) {
+            const bool prev   = _state & STATE_INSIDE;
+            const bool inside = !(_state & (STATE_LOW | STATE_HIGH));
+            if (prev != inside) {
+                _state ^= STATE_INSIDE;
+                ev |= inside ? EVENT_ENTER_WINDOW : EVENT_LEAVE_WINDOW;
+            }
+        }
+        return ev;
+    }
+
+private:
+    Threshold _th{};
+    uint8_t _state{};
+    uint8_t _cnt_low{}, _cnt_high{};
+};
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
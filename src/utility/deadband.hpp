@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file deadband.hpp
+  @brief Deadband / report-on-change filter
+  @details Host buildable, no dependency on M5UnitUnified
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_DEADBAND_HPP
+#define M5_UNIT_ANADIG_UTILITY_DEADBAND_HPP
+
+#include <cstdint>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+/*!
+  @struct DeadbandConfig
+  @brief Report-on-change settings
+ */
+struct DeadbandConfig {
+    bool enable{};              //!< Enable report-on-change
+    uint16_t deadband{};        //!< Report if |value - last reported| > deadband (Raw value)
+    uint32_t max_silence_ms{};  //!< Report if elapsed time since last report >= this (0: Disabled)
+};
+
+/*!
+  @class Deadband
+  @brief Report-on-change filter for raw values
+  @details The first sample after reset is always reported
+ */
+class Deadband {
+public:
+    Deadband() = default;
+
+    //! @brief Gets the settings
+    inline const DeadbandConfig& config() const
+    {
+        return _cfg;
+    }
+    //! @brief Set the settings and reset
+    inline void config(const DeadbandConfig& cfg)
+    {
+        _cfg = cfg;
+        reset();
+    }
+    //! @brief Reset the last reported value and statistics
+    inline void reset()
+    {
+        _has_last = false;
+        _received = _reported = 0;
+    }
+    //! @brief Is enabled?
+    inline bool enabled() const
+    {
+        return _cfg.enable;
+    }
+
+    /*!
+      @brief Should the value be reported?
+      @param v Raw value
+      @param now_ms Current time(ms)
+      @return True if reported
+     */
+    inline bool pass(const int16_t v, const uint32_t now_ms)
+    {
+        ++_received;
+        const int32_t diff = static_cast<int32_t>(v) - _last;
+        const bool changed = !_has_last || diff > _cfg.deadband || -diff > _cfg.deadband;
+        const bool timeout = _cfg.max_silence_ms && (now_ms - _last_at >= _cfg.max_silence_ms);
+        if (changed || timeout) {
+            _last     = v;
+            _last_at  = now_ms;
+            _has_last = true;
+            ++_reported;
+            return true;
+        }
+        return false;
+    }
+
+    ///@name Statistics
+    ///@{
+    //! @brief Number of received samples
+    inline uint32_t received() const
+    {
+        return _received;
+    }
+    //! @brief Number of reported samples
+    inline uint32_t reported() const
+    {
+        return _reported;
+    }
+    //! @brief Compression ratio (received / reported, 0 if nothing reported)
+    inline float ratio() const
+    {
+        return _reported ? static_cast<float>(_received) / _reported : 0.0f;
+    }
+    ///@}
+
+private:
+    DeadbandConfig _cfg{};
+    int16_t _last{};
+    bool _has_last{};
+    uint32_t _last_at{};
+    uint32_t _received{}, _reported{};
+};
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
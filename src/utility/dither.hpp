@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file dither.hpp
+  @brief First-order sigma-delta dithering of DAC codes
+  @details Host buildable, no dependency on M5UnitUnified
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_DITHER_HPP
+#define M5_UNIT_ANADIG_UTILITY_DITHER_HPP
+
+#include <cstdint>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+/*!
+  @class SigmaDelta
+  @brief Alternates adjacent codes so that the average equals the fractional target
+  @details The fraction is accumulated (error feedback) and the upper code is output on each carry.
+  After low-pass filtering, the output reaches 1/256 LSB resolution on average
+ */
+class SigmaDelta {
+public:
+    static constexpr uint8_t FRAC_BITS{8};  //!< Fractional bits of the target
+
+    /*!
+      @brief Set the target
+      @param code_q8 Target code in Q24.8
+      @param max_code Maximum code
+      @note The accumulated error is kept for the continuity of the average
+     */
+    inline void setTarget(const uint32_t code_q8, const uint16_t max_code)
+    {
+        const uint32_t lim = static_cast<uint32_t>(max_code) << FRAC_BITS;
+        _target            = (code_q8 < lim) ? code_q8 : lim;
+    }
+    //! @brief Gets the target code in Q24.8
+    inline uint32_t target() const
+    {
+        return _target;
+    }
+    //! @brief Does the target have a fraction?
+    inline bool fractional() const
+    {
+        return (_target & ((1U << FRAC_BITS) - 1)) != 0;
+    }
+    //! @brief Gets the next code
+    inline uint16_t next()
+    {
+        _acc += _target & ((1U << FRAC_BITS) - 1);
+        const uint16_t carry = _acc >> FRAC_BITS;
+        _acc &= (1U << FRAC_BITS) - 1;
+        return static_cast<uint16_t>((_target >> FRAC_BITS) + carry);
+    }
+    //! @brief Clear the accumulated error
+    inline void reset()
+    {
+        _acc = 0;
+    }
+
+private:
+    uint32_t _target{};
+    uint16_t _acc{};
+};
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,220 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file fixed_point.hpp
+  @brief Integer-only (no-FPU) conversion between codes and voltages
+  @details Host buildable, no dependency on M5UnitUnified
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_FIXED_POINT_HPP
+#define M5_UNIT_ANADIG_UTILITY_FIXED_POINT_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+namespace m5 {
+namespace unit {
+
+/*!
+  @namespace anadig
+  @brief Device independent helpers for ADC/DAC
+ */
+namespace anadig {
+
+///@name Float reference path
+///@{
+/*!
+  @brief ADC code to voltage(mV)
+  @param value Signed code
+  @param min_code Minimum code of the data rate (negative)
+  @param gain_shift log2 of PGA gain
+  @param vdd VDD(mV)
+  @param factor Correction factor
+ */
+inline float adc_code_to_voltage(const int16_t value, const int32_t min_code, const uint8_t gain_shift,
+                                 const float vdd, const float factor)
+{
+    return value / (-min_code / vdd * (1U << gain_shift)) / factor;
+}
+
+/*!
+  @brief Voltage(mV) to DAC code
+  @param mv Voltage(mV)
+  @param clamp_mv Upper limit of the voltage(mV)
+  @param full_mv Voltage(mV) of max_code
+  @param max_code Maximum code
+ */
+inline uint16_t dac_voltage_to_code(const float mv, const float clamp_mv, const float full_mv,
+                                    const uint16_t max_code)
+{
+    float val = std::fmin(std::fmax(mv, 0.0f), clamp_mv);
+    return static_cast<uint16_t>((val / full_mv) * max_code);
+}
+
+/*!
+  @brief Voltage(mV) to voltage(uV) for the integer path
+  @return Rounded to nearest, saturated to int32_t. 0 if NaN
+ */
+inline int32_t mv_to_microvoltage(const float mv)
+{
+    const float uv = mv * 1000.0f;
+    if (std::isnan(uv)) {
+        return 0;
+    }
+    // 2147483520 is the largest float below 2^31
+    if (uv >= 2147483520.0f || uv <= -2147483520.0f) {
+        return (uv > 0.0f) ? INT32_MAX : INT32_MIN;
+    }
+    return static_cast<int32_t>(std::lround(uv));
+}
+
+//! @brief DAC code to voltage(mV)
+inline float dac_code_to_voltage(const uint16_t code, const float full_mv, const uint16_t max_code)
+{
+    return static_cast<float>(code) * full_mv / max_code;
+}
+
+/*!
+  @struct FloatCodeScale
+  @brief Voltage(mV) to DAC code using the precomputed reciprocal
+  @details Same as dac_voltage_to_code without the division. Within 1 code of it
+ */
+struct FloatCodeScale {
+    float clamp_mv{};     //!< Upper limit of the voltage(mV)
+    float code_per_mv{};  //!< Code per mV
+
+    constexpr FloatCodeScale()
+    {
+    }
+    //! @brief Make the scale
+    constexpr FloatCodeScale(const uint16_t max_code, const float full_mv, const float clamp)
+        : clamp_mv{clamp}, code_per_mv{max_code / full_mv}
+    {
+    }
+
+    //! @brief Voltage(mV) to code. Negative value and NaN are treated as zero
+    inline uint16_t to_code(const float mv) const
+    {
+        const float v = (mv > 0.0f) ? ((mv < clamp_mv) ? mv : clamp_mv) : 0.0f;
+        return static_cast<uint16_t>(v * code_per_mv);
+    }
+    /*!
+      @brief Convert the voltages in a single pass
+      @param[out] codes Codes
+      @param mv Voltages(mV)
+      @param num Number of values
+      @note Branch-free loop body so that the compiler can vectorize it
+     */
+    inline void to_codes(uint16_t* codes, const float* mv, const size_t num) const
+    {
+        const float lim = clamp_mv;
+        const float k   = code_per_mv;
+        for (size_t i = 0; i < num; ++i) {
+            const float v = (mv[i] > 0.0f) ? ((mv[i] < lim) ? mv[i] : lim) : 0.0f;
+            codes[i]      = static_cast<uint16_t>(v * k);
+        }
+    }
+};
+///@}
+
+///@name Integer path
+///@{
+/*!
+  @brief Voltage(uV) per ADC LSB in Q16.16
+  @details Calculated once when the configuration is changed
+ */
+inline uint32_t adc_lsb_microvoltage_q16(const int32_t min_code, const uint8_t gain_shift, const float vdd,
+                                         const float factor)
+{
+    return static_cast<uint32_t>(std::lround(static_cast<double>(vdd) * 1000.0 * 65536.0 /
+                                             (-static_cast<double>(min_code) * (1U << gain_shift) * factor)));
+}
+
+/*!
+  @brief ADC code to voltage(uV)
+  @param value Signed code
+  @param lsb_q16 Voltage(uV) per LSB in Q16.16
+  @note Rounded to nearest. Error is less than 1 uV against the exact value
+ */
+inline int32_t adc_code_to_microvoltage(const int16_t value, const uint32_t lsb_q16)
+{
+    return static_cast<int32_t>((static_cast<int64_t>(value) * lsb_q16 + 0x8000) >> 16);
+}
+
+//! @brief Integer square root (Rounded down)
+inline uint32_t isqrt(uint64_t v)
+{
+    uint64_t r{}, bit = static_cast<uint64_t>(1) << 62;
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (v >= r + bit) {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return static_cast<uint32_t>(r);
+}
+
+/*!
+  @struct CodeScale
+  @brief Linear conversion between voltage(uV) and DAC code using precomputed reciprocals
+  @details Tolerance against the float reference path (dac_voltage_to_code / dac_code_to_voltage)
+  - to_code: Within 1 code (The float path truncates after a rounded division)
+  - to_microvoltage: Within 1 uV of the exact value
+ */
+struct CodeScale {
+    uint32_t max_code{};  //!< Maximum code
+    uint32_t full_uv{};   //!< Voltage(uV) of max_code
+    uint32_t clamp_uv{};  //!< Upper limit of the voltage(uV)
+    uint32_t code_q32{};  //!< Code per uV in Q0.32 (Rounded up)
+    uint32_t uv_q16{};    //!< Voltage(uV) per code in Q16.16
+
+    constexpr CodeScale()
+    {
+    }
+    //! @brief Make the scale (Integer only)
+    constexpr CodeScale(const uint32_t maxc, const uint32_t full, const uint32_t clamp)
+        : max_code{maxc},
+          full_uv{full},
+          clamp_uv{clamp},
+          code_q32{static_cast<uint32_t>(((static_cast<uint64_t>(maxc) << 32) + full - 1) / full)},
+          uv_q16{static_cast<uint32_t>(((static_cast<uint64_t>(full) << 16) + maxc / 2) / maxc)}
+    {
+    }
+
+    //! @brief Voltage(uV) to code. Negative value is treated as zero
+    inline uint16_t to_code(const int32_t uv) const
+    {
+        uint32_t v = (uv > 0) ? static_cast<uint32_t>(uv) : 0U;
+        v          = (v < clamp_uv) ? v : clamp_uv;
+        uint32_t c = static_cast<uint32_t>((static_cast<uint64_t>(v) * code_q32) >> 32);
+        return static_cast<uint16_t>((c < max_code) ? c : max_code);
+    }
+    //! @brief Voltage(uV) to code in Q24.8 (With the fraction below 1 code)
+    inline uint32_t to_code_q8(const int32_t uv) const
+    {
+        uint32_t v = (uv > 0) ? static_cast<uint32_t>(uv) : 0U;
+        v          = (v < clamp_uv) ? v : clamp_uv;
+        uint32_t c = static_cast<uint32_t>((static_cast<uint64_t>(v) * code_q32) >> 24);
+        return (c < (max_code << 8)) ? c : (max_code << 8);
+    }
+    //! @brief Code to voltage(uV)
+    inline int32_t to_microvoltage(const uint16_t code) const
+    {
+        return static_cast<int32_t>((static_cast<uint64_t>(code) * uv_q16 + 0x8000) >> 16);
+    }
+};
+///@}
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
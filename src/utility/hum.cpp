@@ -0,0 +1,223 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file hum.cpp
+  @brief Mains hum detection (Goertzel) and rejection (Notch / synchronous average)
+*/
+#include "hum.hpp"
+#include "fixed_point.hpp"
+#include <cmath>
+
+namespace {
+
+constexpr double PI{3.14159265358979323846};
+
+// Frequency aliased into [0, sample_rate / 2]
+double alias(const double sample_rate, const double freq)
+{
+    const double f = std::fmod(freq, sample_rate);
+    return (f > sample_rate * 0.5) ? sample_rate - f : f;
+}
+
+}  // namespace
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+constexpr uint16_t Goertzel::MAX_BLOCK;
+
+bool Goertzel::begin(const float sample_rate, const float freq, const uint16_t block)
+{
+    _block = 0;
+    if (sample_rate <= 0.f || freq <= 0.f || block < 2 || block > MAX_BLOCK) {
+        return false;
+    }
+    _coeff     = std::llround(2.0 * std::cos(2.0 * PI * freq / sample_rate) * (1 << 30));
+    _block     = block;
+    _amplitude = _blocks = 0;
+    reset();
+    return true;
+}
+
+bool Goertzel::push(const int16_t x)
+{
+    if (!_block) {
+        return false;
+    }
+    // s in Q8
+    const int64_t s = (static_cast<int64_t>(x) << 8) + ((_coeff * _s1) >> 30) - _s2;
+    _s2             = _s1;
+    _s1             = s;
+    if (++_count < _block) {
+        return false;
+    }
+    // |X|^2 = s1^2 + s2^2 - coeff * s1 * s2 (in Q8 to keep the headroom)
+    const int64_t s1 = _s1 >> 4;
+    const int64_t s2 = _s2 >> 4;
+    const int64_t p  = s1 * s1 + s2 * s2 - ((_coeff * s1) >> 30) * s2;
+    // Peak amplitude = 2|X| / N
+    _amplitude = static_cast<uint32_t>((static_cast<uint64_t>(isqrt(p > 0 ? p : 0)) << 5) / _block);
+    ++_blocks;
+    reset();
+    return true;
+}
+
+bool Notch::begin(const float sample_rate, const float freq, const float bandwidth)
+{
+    _b0 = 0;
+    if (sample_rate <= 0.f || freq <= 0.f || bandwidth <= 0.f) {
+        return false;
+    }
+    const double c = std::cos(2.0 * PI * freq / sample_rate);
+    const double r = 1.0 - PI * bandwidth / sample_rate;
+    if (r <= 0.0 || 1.0 - c < 1e-6) {
+        return false;  // Too wide or at DC
+    }
+    // Normalized to unity gain at DC
+    const double g = (1.0 - 2.0 * r * c + r * r) / (2.0 - 2.0 * c);
+    _b0            = std::llround(g * (1 << 28));
+    _b1            = std::llround(-2.0 * g * c * (1 << 28));
+    _a1            = std::llround(-2.0 * r * c * (1 << 28));
+    _a2            = std::llround(r * r * (1 << 28));
+    reset();
+    return true;
+}
+
+int16_t Notch::process(const int16_t x)
+{
+    if (!_b0) {
+        return x;
+    }
+    if (!_primed) {
+        _x1 = _x2 = x;
+        _y1 = _y2 = static_cast<int32_t>(x) << 8;
+        _primed   = true;
+    }
+    // Q36 to Q8
+    const int64_t acc = _b0 * ((static_cast<int64_t>(x) + _x2) << 8) + _b1 * (static_cast<int64_t>(_x1) << 8) -
+                        _a1 * _y1 - _a2 * _y2;
+    const int32_t y = static_cast<int32_t>((acc + (1 << 27)) >> 28);
+    _x2             = _x1;
+    _x1             = x;
+    _y2             = _y1;
+    _y1             = y;
+
+    const int32_t v = (y + 128) >> 8;
+    return (v < -32768) ? -32768 : (v > 32767) ? 32767 : static_cast<int16_t>(v);
+}
+
+bool SyncAverage::begin(const uint16_t window)
+{
+    _window = 0;
+    if (!window) {
+        return false;
+    }
+    _buf.reset(new int16_t[window]);
+    if (!_buf) {
+        return false;
+    }
+    _window = window;
+    reset();
+    return true;
+}
+
+int16_t SyncAverage::process(const int16_t x)
+{
+    if (!_window) {
+        return x;
+    }
+    if (_count < _window) {
+        ++_count;
+    } else {
+        _sum -= _buf[_pos];
+    }
+    _sum += x;
+    _buf[_pos] = x;
+    _pos       = (_pos + 1) % _window;
+
+    const int32_t half = _count / 2;
+    return static_cast<int16_t>((_sum < 0 ? _sum - half : _sum + half) / _count);
+}
+
+uint16_t hum_window(const float sample_rate, const float freq, const uint16_t max_window)
+{
+    if (sample_rate <= 0.f || freq <= 0.f) {
+        return 0;
+    }
+    const double f = alias(sample_rate, freq);
+    if (f < sample_rate * 1e-3) {
+        return 0;  // Rejected by the ADC itself
+    }
+    for (uint16_t n = 2; n <= max_window; ++n) {
+        const double cycles = n * f / sample_rate;
+        if (std::fabs(cycles - std::round(cycles)) < 1e-3) {
+            return n;
+        }
+    }
+    return 0;
+}
+
+bool HumRejector::begin(const float sample_rate, const HumConfig& cfg)
+{
+    _cfg     = cfg;
+    _enabled = false;
+    if (!cfg.enable) {
+        return true;
+    }
+    const uint16_t window = hum_window(sample_rate, cfg.freq);
+    if (!window) {
+        return false;
+    }
+    // The longer block, the narrower bin (Whole periods for no leakage)
+    const uint16_t block = cfg.block ? cfg.block : (Goertzel::MAX_BLOCK / window) * window;
+    if (!_detector.begin(sample_rate, cfg.freq, block)) {
+        return false;
+    }
+    switch (cfg.filter) {
+        case HumFilter::Notch:
+            if (!_notch.begin(sample_rate, cfg.freq, cfg.bandwidth)) {
+                return false;
+            }
+            break;
+        case HumFilter::Average:
+            if (!_average.begin(window)) {
+                return false;
+            }
+            break;
+        default:
+            break;
+    }
+    _enabled = true;
+    return true;
+}
+
+void HumRejector::reset()
+{
+    _detector.reset();
+    _notch.reset();
+    _average.reset();
+}
+
+int16_t HumRejector::process(const int16_t x)
+{
+    if (!_enabled) {
+        return x;
+    }
+    _detector.push(x);
+    switch (_cfg.filter) {
+        case HumFilter::Notch:
+            return _notch.process(x);
+        case HumFilter::Average:
+            return _average.process(x);
+        default:
+            return x;
+    }
+}
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
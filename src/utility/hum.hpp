@@ -0,0 +1,219 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file hum.hpp
+  @brief Mains hum detection (Goertzel) and rejection (Notch / synchronous average)
+  @details Host buildable, no dependency on M5UnitUnified
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_HUM_HPP
+#define M5_UNIT_ANADIG_UTILITY_HUM_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+/*!
+  @class Goertzel
+  @brief Block-based amplitude detector of a single frequency
+  @note Fixed point. Without leakage if the block is whole periods of the frequency
+ */
+class Goertzel {
+public:
+    static constexpr uint16_t MAX_BLOCK{256};  //!< Maximum block size
+
+    /*!
+      @brief Set up the detector
+      @param sample_rate Sampling rate(Hz)
+      @param freq Frequency(Hz) to detect (Aliased frequency is also detected)
+      @param block Block size (2 - MAX_BLOCK)
+      @return True if successful
+     */
+    bool begin(const float sample_rate, const float freq, const uint16_t block);
+    //! @brief Restart the current block
+    inline void reset()
+    {
+        _s1 = _s2 = 0;
+        _count    = 0;
+    }
+    /*!
+      @brief Push a sample
+      @param x Raw value
+      @return True if a block is completed and amplitude() is updated
+     */
+    bool push(const int16_t x);
+
+    //! @brief Peak amplitude of the last block (Raw value in Q8)
+    inline uint32_t amplitude() const
+    {
+        return _amplitude;
+    }
+    //! @brief Number of completed blocks
+    inline uint32_t blocks() const
+    {
+        return _blocks;
+    }
+    //! @brief Block size
+    inline uint16_t block() const
+    {
+        return _block;
+    }
+
+private:
+    int64_t _coeff{};  // 2cos(w) in Q30
+    int64_t _s1{}, _s2{};
+    uint16_t _block{}, _count{};
+    uint32_t _amplitude{}, _blocks{};
+};
+
+/*!
+  @class Notch
+  @brief Second order IIR notch with unity DC gain
+  @note Fixed point (Q28 coefficients)
+ */
+class Notch {
+public:
+    /*!
+      @brief Set up the filter
+      @param sample_rate Sampling rate(Hz)
+      @param freq Notch frequency(Hz) (Aliased frequency is rejected)
+      @param bandwidth -3dB bandwidth(Hz)
+      @return True if successful
+     */
+    bool begin(const float sample_rate, const float freq, const float bandwidth);
+    //! @brief Reset the state (The next sample starts in the steady state)
+    inline void reset()
+    {
+        _primed = false;
+    }
+    /*!
+      @brief Filter a sample
+      @param x Raw value
+      @return Filtered raw value
+     */
+    int16_t process(const int16_t x);
+
+private:
+    int64_t _b0{}, _b1{}, _a1{}, _a2{};  // b2 == b0
+    int32_t _x1{}, _x2{}, _y1{}, _y2{};  // y in Q8
+    bool _primed{};
+};
+
+/*!
+  @class SyncAverage
+  @brief Moving average over whole periods of the hum
+  @details Rejects the frequency and its harmonics, at the cost of the bandwidth
+ */
+class SyncAverage {
+public:
+    /*!
+      @brief Set up the filter
+      @param window Number of samples (Whole periods, see also hum_window)
+      @return True if successful
+     */
+    bool begin(const uint16_t window);
+    //! @brief Reset the state
+    inline void reset()
+    {
+        _count = _pos = 0;
+        _sum          = 0;
+    }
+    /*!
+      @brief Filter a sample
+      @param x Raw value
+      @return Average of the window (Of the received samples until the window is filled)
+     */
+    int16_t process(const int16_t x);
+
+private:
+    std::unique_ptr<int16_t[]> _buf{};
+    uint16_t _window{}, _count{}, _pos{};
+    int32_t _sum{};
+};
+
+/*!
+  @brief Gets the smallest number of samples of whole periods
+  @param sample_rate Sampling rate(Hz)
+  @param freq Frequency(Hz)
+  @param max_window Maximum number of samples
+  @return Number of samples, 0 if not found or the frequency aliases to DC
+  @note 24 samples at 240 SPS are whole periods of both 50Hz and 60Hz (10Hz)
+ */
+uint16_t hum_window(const float sample_rate, const float freq, const uint16_t max_window = Goertzel::MAX_BLOCK);
+
+//! @brief Hum filter
+enum class HumFilter : uint8_t {
+    None,     //!< Detection only
+    Notch,    //!< IIR notch (Keeps the bandwidth)
+    Average,  //!< Synchronous average (Rejects the harmonics)
+};
+
+/*!
+  @struct HumConfig
+  @brief Hum rejection settings
+ */
+struct HumConfig {
+    bool enable{};                       //!< Enable hum rejection
+    float freq{50.f};                    //!< Mains frequency(Hz)
+    HumFilter filter{HumFilter::Notch};  //!< Filter
+    float bandwidth{4.f};                //!< -3dB bandwidth(Hz) of the notch
+    uint16_t block{};                    //!< Block size of the detector (0: Multiple of hum_window up to MAX_BLOCK)
+};
+
+/*!
+  @class HumRejector
+  @brief Detects the hum on the input and removes it from the output
+ */
+class HumRejector {
+public:
+    //! @brief Gets the settings
+    inline const HumConfig& config() const
+    {
+        return _cfg;
+    }
+    /*!
+      @brief Set up the rejector
+      @param sample_rate Sampling rate(Hz)
+      @param cfg Settings
+      @return True if successful
+      @note Disabled if failed
+     */
+    bool begin(const float sample_rate, const HumConfig& cfg);
+    //! @brief Reset the state
+    void reset();
+    //! @brief Is enabled?
+    inline bool enabled() const
+    {
+        return _enabled;
+    }
+    /*!
+      @brief Process a sample
+      @param x Raw value
+      @return Filtered raw value
+     */
+    int16_t process(const int16_t x);
+
+    //! @brief Gets the detector
+    inline const Goertzel& detector() const
+    {
+        return _detector;
+    }
+
+private:
+    HumConfig _cfg{};
+    bool _enabled{};
+    Goertzel _detector{};
+    Notch _notch{};
+    SyncAverage _average{};
+};
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,182 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file linearity.cpp
+  @brief Linearity analysis and correction of DAC/ADC transfer functions
+*/
+#include "linearity.hpp"
+#include <cmath>
+
+namespace {
+// Least squares uv = a * x(code) + b
+template <typename F>
+bool fit_points(const m5::unit::anadig::LinearityPoint* points, const size_t num, F x_of, double& a, double& b)
+{
+    if (!points || num < 2) {
+        return false;
+    }
+    double sx{}, sy{}, sxx{}, sxy{};
+    for (size_t i = 0; i < num; ++i) {
+        const double x = x_of(points[i].code);
+        const double y = points[i].uv;
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+    const double den = num * sxx - sx * sx;
+    if (den == 0.0) {
+        return false;
+    }
+    a = (num * sxy - sx * sy) / den;
+    b = (sy - a * sx) / num;
+    return true;
+}
+
+// Not narrowed, the caller clamps the result (Extrapolation may exceed int32_t)
+inline int64_t div_round(const int64_t n, const int64_t d)
+{
+    return ((n < 0) != (d < 0)) ? (n - d / 2) / d : (n + d / 2) / d;
+}
+}  // namespace
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+constexpr uint8_t DacCorrection::MAX_POINTS;
+
+bool analyze_linearity(const LinearityPoint* points, const size_t num, LinearityResult& result, float* inl,
+                       float* step_error)
+{
+    double a{}, b{};
+    if (!fit_points(points, num, [](const uint16_t c) { return static_cast<double>(c); }, a, b) || a == 0.0) {
+        return false;
+    }
+    result         = LinearityResult{};
+    result.slope   = static_cast<float>(a);
+    result.offset  = static_cast<float>(b);
+    result.step_error_max = -1e9f;
+    result.step_error_min = 1e9f;
+    for (size_t i = 0; i < num; ++i) {
+        const float e  = static_cast<float>((points[i].uv - (a * points[i].code + b)) / a);
+        result.inl_max = std::fmax(result.inl_max, std::fabs(e));
+        if (inl) {
+            inl[i] = e;
+        }
+        if (i + 1 < num) {
+            const int32_t dc = static_cast<int32_t>(points[i + 1].code) - points[i].code;
+            // Average per code of the step
+            const float d = dc ? static_cast<float>((points[i + 1].uv - points[i].uv) / (a * dc) - 1.0) : 0.0f;
+
+            result.step_error_max = std::fmax(result.step_error_max, d);
+            result.step_error_min = std::fmin(result.step_error_min, d);
+            if (step_error) {
+                step_error[i] = d;
+            }
+        }
+    }
+    return true;
+}
+
+bool adc_correction(const LinearityPoint* points, const size_t num, const CodeScale& dac, GainOffset& correction)
+{
+    // measured = a * nominal + b, corrected = (measured - b) / a
+    double a{}, b{};
+    if (!fit_points(points, num, [&dac](const uint16_t c) { return static_cast<double>(dac.to_microvoltage(c)); },
+                    a, b) ||
+        a <= 0.0) {
+        return false;
+    }
+    correction.gain_q16  = static_cast<int32_t>(std::lround(65536.0 / a));
+    correction.offset_uv = static_cast<int32_t>(std::lround(-b / a));
+    return true;
+}
+
+bool DacCorrection::build(const LinearityPoint* points, const size_t num, const uint16_t max_code)
+{
+    _num = 0;
+    if (!points || num < 2 || num > MAX_POINTS) {
+        return false;
+    }
+    for (size_t i = 1; i < num; ++i) {
+        if (points[i].code <= points[i - 1].code || points[i].uv <= points[i - 1].uv) {
+            return false;  // Not monotonic
+        }
+    }
+    for (size_t i = 0; i < num; ++i) {
+        _points[i] = points[i];
+    }
+    _num      = static_cast<uint8_t>(num);
+    _max_code = max_code;
+    return true;
+}
+
+// Lower index of the segment including uv (End segments for extrapolation)
+uint8_t DacCorrection::segment_of_uv(const int32_t uv) const
+{
+    uint8_t lo{0}, hi{static_cast<uint8_t>(_num - 1)};
+    while (hi - lo > 1) {
+        const uint8_t mid = (lo + hi) / 2;
+        if (uv < _points[mid].uv) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+    return lo;
+}
+
+uint16_t DacCorrection::to_code(const int32_t uv) const
+{
+    if (!valid()) {
+        return 0;
+    }
+    const uint8_t lo         = segment_of_uv(uv);
+    const LinearityPoint& p0 = _points[lo];
+    const LinearityPoint& p1 = _points[lo + 1];
+    const int64_t n          = (static_cast<int64_t>(uv) - p0.uv) * (p1.code - p0.code);
+    const int64_t c          = p0.code + div_round(n, p1.uv - p0.uv);
+    return static_cast<uint16_t>((c < 0) ? 0 : (c > _max_code) ? _max_code : c);
+}
+
+uint32_t DacCorrection::to_code_q8(const int32_t uv) const
+{
+    if (!valid()) {
+        return 0;
+    }
+    const uint8_t lo         = segment_of_uv(uv);
+    const LinearityPoint& p0 = _points[lo];
+    const LinearityPoint& p1 = _points[lo + 1];
+    const int64_t n          = (static_cast<int64_t>(uv) - p0.uv) * (p1.code - p0.code) * 256;
+    const int64_t c          = (static_cast<int64_t>(p0.code) << 8) + div_round(n, p1.uv - p0.uv);
+    const int64_t lim        = static_cast<int64_t>(_max_code) << 8;
+    return static_cast<uint32_t>((c < 0) ? 0 : (c > lim) ? lim : c);
+}
+
+int32_t DacCorrection::to_microvoltage(const uint16_t code) const
+{
+    if (!valid()) {
+        return 0;
+    }
+    uint8_t lo{0}, hi{static_cast<uint8_t>(_num - 1)};
+    while (hi - lo > 1) {
+        const uint8_t mid = (lo + hi) / 2;
+        if (code < _points[mid].code) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+    const LinearityPoint& p0 = _points[lo];
+    const LinearityPoint& p1 = _points[hi];
+    const int64_t uv = p0.uv + div_round((static_cast<int64_t>(code) - p0.code) * (p1.uv - p0.uv), p1.code - p0.code);
+    return static_cast<int32_t>((uv < INT32_MIN) ? INT32_MIN : (uv > INT32_MAX) ? INT32_MAX : uv);
+}
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
@@ -0,0 +1,153 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file linearity.hpp
+  @brief Linearity analysis and correction of DAC/ADC transfer functions
+  @details Host buildable, no dependency on M5UnitUnified
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_LINEARITY_HPP
+#define M5_UNIT_ANADIG_UTILITY_LINEARITY_HPP
+
+#include "fixed_point.hpp"
+#include <cstdint>
+#include <cstddef>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+/*!
+  @struct LinearityPoint
+  @brief DAC code and the measured voltage
+ */
+struct LinearityPoint {
+    uint16_t code;  //!< DAC code
+    int32_t uv;     //!< Measured voltage(uV)
+};
+
+/*!
+  @struct LinearityResult
+  @brief Result of the analysis
+  @details INL is against the best fit line, in LSB of the fitted slope.
+  The step error is the gain error of each step between the points, averaged over the codes of the step.
+  It is the DNL only if the points are on consecutive codes (e.g. a dense sweep of a part of the range);
+  a step over many codes cannot show a missing or non-monotonic code
+ */
+struct LinearityResult {
+    float slope{};           //!< Fitted voltage(uV) per code
+    float offset{};          //!< Fitted voltage(uV) at code 0
+    float inl_max{};         //!< Maximum |INL| (LSB)
+    float step_error_max{};  //!< Maximum step error (LSB per code)
+    float step_error_min{};  //!< Minimum step error (LSB per code)
+};
+
+/*!
+  @brief Analyze the linearity
+  @param points Points in ascending order of code
+  @param num Number of points (At least 2)
+  @param[out] result Result
+  @param[out] inl INL of each point (LSB, num elements, optional)
+  @param[out] step_error Step error of each step (LSB per code, num - 1 elements, optional)
+  @return True if successful
+ */
+bool analyze_linearity(const LinearityPoint* points, const size_t num, LinearityResult& result, float* inl = nullptr,
+                       float* step_error = nullptr);
+
+/*!
+  @struct GainOffset
+  @brief Gain and offset correction
+  @details corrected = uv * gain + offset
+ */
+struct GainOffset {
+    int32_t gain_q16{65536};  //!< Gain in Q16.16
+    int32_t offset_uv{};      //!< Offset(uV)
+
+    //! @brief Apply the correction
+    inline int32_t apply(const int32_t uv) const
+    {
+        return static_cast<int32_t>((static_cast<int64_t>(uv) * gain_q16 + 0x8000) >> 16) + offset_uv;
+    }
+    //! @brief Is identity?
+    inline bool identity() const
+    {
+        return gain_q16 == 65536 && offset_uv == 0;
+    }
+    //! @brief Is valid? (Positive gain)
+    inline bool valid() const
+    {
+        return gain_q16 > 0;
+    }
+};
+
+/*!
+  @brief Gain and offset correction of the ADC using the DAC as the reference
+  @param points Measured points
+  @param num Number of points (At least 2)
+  @param dac Nominal scale of the DAC
+  @param[out] correction Correction that maps the measured voltage to the nominal DAC voltage
+  @return True if successful
+ */
+bool adc_correction(const LinearityPoint* points, const size_t num, const CodeScale& dac, GainOffset& correction);
+
+/*!
+  @class DacCorrection
+  @brief Piecewise linear correction of the DAC using the ADC as the reference
+  @details Voltage to code by interpolating the measured points inversely, extrapolated by the end segments
+ */
+class DacCorrection {
+public:
+    static constexpr uint8_t MAX_POINTS{65};  //!< Maximum number of points
+
+    DacCorrection() = default;
+
+    /*!
+      @brief Build from the measured points
+      @param points Points in ascending order of code, the voltage must also ascend
+      @param num Number of points (2 - MAX_POINTS)
+      @param max_code Maximum code of the DAC
+      @return True if successful
+     */
+    bool build(const LinearityPoint* points, const size_t num, const uint16_t max_code);
+    //! @brief Remove the points
+    inline void clear()
+    {
+        _num = 0;
+    }
+    //! @brief Is valid?
+    inline bool valid() const
+    {
+        return _num >= 2;
+    }
+    //! @brief Number of points
+    inline uint8_t size() const
+    {
+        return _num;
+    }
+    //! @brief Gets the point
+    inline const LinearityPoint& point(const uint8_t idx) const
+    {
+        return _points[idx < _num ? idx : 0];
+    }
+
+    //! @brief Voltage(uV) to code (Rounded to nearest, clamped)
+    uint16_t to_code(const int32_t uv) const;
+    //! @brief Voltage(uV) to code in Q24.8 (With the fraction below 1 code, clamped)
+    uint32_t to_code_q8(const int32_t uv) const;
+    //! @brief Code to the expected voltage(uV)
+    int32_t to_microvoltage(const uint16_t code) const;
+
+private:
+    uint8_t segment_of_uv(const int32_t uv) const;
+
+    LinearityPoint _points[MAX_POINTS]{};
+    uint8_t _num{};
+    uint16_t _max_code{};
+};
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
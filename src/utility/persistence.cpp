@@ -0,0 +1,106 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file persistence.cpp
+  @brief Wear-aware persistence of DAC power-on defaults
+*/
+#include "persistence.hpp"
+#include <algorithm>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+constexpr uint8_t PersistenceManager::MAX_VALUES;
+
+bool PersistenceManager::begin(const uint8_t num, write_function_t write, busy_function_t busy,
+                               const uint32_t settle_ms)
+{
+    if (!num || num > MAX_VALUES || !write) {
+        return false;
+    }
+    _num      = num;
+    _write    = write;
+    _busy     = busy;
+    _settle   = settle_ms;
+    _known    = _pending = false;
+    _requests = _writes = _coalesced = _skipped = _failed = 0;
+    return true;
+}
+
+void PersistenceManager::setStored(const uint16_t* values)
+{
+    if (values) {
+        std::copy(values, values + _num, _stored);
+        _known = true;
+    }
+}
+
+void PersistenceManager::complete(const bool success, const uint32_t now_ms)
+{
+    if (success || !_num) {
+        return;
+    }
+    ++_failed;
+    _known = false;
+    if (!_pending) {
+        // Retry the values of the failed write (Copied to _stored on start)
+        std::copy(_stored, _stored + _num, _request);
+        _requested_at = now_ms;
+        _pending      = true;
+    }
+}
+
+void PersistenceManager::request(const uint16_t* values, const uint32_t now_ms)
+{
+    if (!values || !_num) {
+        return;
+    }
+    ++_requests;
+    if (_pending) {
+        ++_coalesced;
+    }
+    if (_known && std::equal(values, values + _num, _stored)) {
+        // Cancel the pending request and keep the stored values
+        _pending = false;
+        ++_skipped;
+        return;
+    }
+    std::copy(values, values + _num, _request);
+    _requested_at = now_ms;
+    _pending      = true;
+}
+
+bool PersistenceManager::update(const uint32_t now_ms)
+{
+    return _pending && now_ms - _requested_at >= _settle && write(now_ms);
+}
+
+bool PersistenceManager::flush(const uint32_t now_ms)
+{
+    return _pending && write(now_ms);
+}
+
+bool PersistenceManager::write(const uint32_t now_ms)
+{
+    if (_busy && _busy()) {
+        return false;  // Try again on the next call
+    }
+    if (!_write(_request, _num)) {
+        ++_failed;
+        _requested_at = now_ms;  // Retry after the settle time
+        return false;
+    }
+    std::copy(_request, _request + _num, _stored);
+    _known   = true;
+    _pending = false;
+    ++_writes;
+    return true;
+}
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
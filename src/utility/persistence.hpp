@@ -0,0 +1,156 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file persistence.hpp
+  @brief Wear-aware persistence of DAC power-on defaults
+  @details Host buildable, no dependency on M5UnitUnified
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_PERSISTENCE_HPP
+#define M5_UNIT_ANADIG_UTILITY_PERSISTENCE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+/*!
+  @class PersistenceManager
+  @brief Writes the non-volatile memory only when needed
+  @details Keeps a cached copy of the stored values.
+  Requests are coalesced until no new request arrives for the settle time,
+  and the write is skipped if the values are the same as the stored ones
+  @note One manager per device. See also UnitMCP4725::setupPersistence and UnitGP8413::setupPersistence
+ */
+class PersistenceManager {
+public:
+    static constexpr uint8_t MAX_VALUES{2};  //!< Maximum number of values (channels)
+
+    /*!
+      @brief Start writing the values to the non-volatile memory
+      @return True if started
+     */
+    using write_function_t = std::function<bool(const uint16_t* values, const uint8_t num)>;
+    //! @brief Is the non-volatile memory write in progress?
+    using busy_function_t = std::function<bool()>;
+
+    PersistenceManager() = default;
+
+    /*!
+      @brief Set up the manager
+      @param num Number of values (1 - MAX_VALUES)
+      @param write Function to start writing
+      @param busy Function to check the writing (optional)
+      @param settle_ms Time(ms) to wait for no more requests before writing
+      @return True if successful
+      @note The stored values are unknown until setStored() is called
+     */
+    bool begin(const uint8_t num, write_function_t write, busy_function_t busy, const uint32_t settle_ms);
+    /*!
+      @brief Set the cached copy of the stored values
+      @param values Values read from the device
+     */
+    void setStored(const uint16_t* values);
+    //! @brief Forget the cached copy (The next request is always written)
+    inline void invalidate()
+    {
+        _known = false;
+    }
+    /*!
+      @brief Notify the completion of the started write (For the asynchronous write)
+      @param success True if the values have been stored
+      @param now_ms Current time(ms)
+      @note On failure, the cached copy is forgotten and the values are requested again unless a newer request
+      is pending
+     */
+    void complete(const bool success, const uint32_t now_ms);
+
+    /*!
+      @brief Request to persist the values
+      @param values Values
+      @param now_ms Current time(ms)
+      @note Written in update() after the settle time
+     */
+    void request(const uint16_t* values, const uint32_t now_ms);
+    /*!
+      @brief Write if settled
+      @param now_ms Current time(ms)
+      @return True if a write has been started
+     */
+    bool update(const uint32_t now_ms);
+    /*!
+      @brief Write the pending request without waiting for the settle time
+      @param now_ms Current time(ms)
+      @return True if a write has been started
+     */
+    bool flush(const uint32_t now_ms);
+
+    ///@name Properties
+    ///@{
+    //! @brief Is a request waiting to be written?
+    inline bool pending() const
+    {
+        return _pending;
+    }
+    //! @brief Is the cached copy valid?
+    inline bool known() const
+    {
+        return _known;
+    }
+    //! @brief Gets the stored value (Valid if known())
+    inline uint16_t stored(const uint8_t idx) const
+    {
+        return idx < MAX_VALUES ? _stored[idx] : 0;
+    }
+    ///@}
+
+    ///@name Statistics
+    ///@{
+    //! @brief Number of requests
+    inline uint32_t requests() const
+    {
+        return _requests;
+    }
+    //! @brief Number of writes to the non-volatile memory
+    inline uint32_t writes() const
+    {
+        return _writes;
+    }
+    //! @brief Number of requests replaced by a newer one before written
+    inline uint32_t coalesced() const
+    {
+        return _coalesced;
+    }
+    //! @brief Number of requests skipped because the values were already stored
+    inline uint32_t skipped() const
+    {
+        return _skipped;
+    }
+    //! @brief Number of failed writes, including failed completions (Retried after the settle time)
+    inline uint32_t failed() const
+    {
+        return _failed;
+    }
+    ///@}
+
+private:
+    bool write(const uint32_t now_ms);
+
+    write_function_t _write{};
+    busy_function_t _busy{};
+    uint8_t _num{};
+    uint32_t _settle{}, _requested_at{};
+    uint16_t _stored[MAX_VALUES]{}, _request[MAX_VALUES]{};
+    bool _known{}, _pending{};
+    uint32_t _requests{}, _writes{}, _coalesced{}, _skipped{}, _failed{};
+};
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,64 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file pid.cpp
+  @brief Fixed-point PID controller
+*/
+#include "pid.hpp"
+
+namespace {
+inline int64_t clamp(const int64_t v, const int64_t lo, const int64_t hi)
+{
+    return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+}  // namespace
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+void Pid::reset(const int32_t output)
+{
+    _integral  = clamp(output, _cfg.out_min, _cfg.out_max) * 65536;
+    _output    = static_cast<int32_t>(_integral >> 16);
+    _first     = true;
+    _saturated = false;
+}
+
+int32_t Pid::step(const int32_t setpoint, const int32_t measurement)
+{
+    const int64_t error = static_cast<int64_t>(setpoint) - measurement;
+    if (_first) {
+        _last_error       = static_cast<int32_t>(error);
+        _last_measurement = measurement;
+        _first            = false;
+    }
+
+    const int64_t p = error * _cfg.kp_q16;
+    const int64_t d = _cfg.derivative_on_measurement
+                          ? -(static_cast<int64_t>(measurement) - _last_measurement) * _cfg.kd_q16
+                          : (error - _last_error) * _cfg.kd_q16;
+    const int64_t lo = static_cast<int64_t>(_cfg.out_min) * 65536;
+    const int64_t hi = static_cast<int64_t>(_cfg.out_max) * 65536;
+
+    // Conditional integration
+    const int64_t i = _integral + error * _cfg.ki_q16;
+    const int64_t u = p + i + d;
+    if (!((u > hi && error * _cfg.ki_q16 > 0) || (u < lo && error * _cfg.ki_q16 < 0))) {
+        _integral = clamp(i, lo, hi);
+    }
+
+    const int64_t out = p + _integral + d;
+    _saturated        = (out > hi || out < lo);
+    _output           = static_cast<int32_t>(clamp(out, lo, hi) >> 16);
+    _last_error       = static_cast<int32_t>(error);
+    _last_measurement = measurement;
+    return _output;
+}
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
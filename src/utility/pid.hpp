@@ -0,0 +1,105 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file pid.hpp
+  @brief Fixed-point PID controller
+  @details Host buildable, no dependency on M5UnitUnified
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_PID_HPP
+#define M5_UNIT_ANADIG_UTILITY_PID_HPP
+
+#include <cstdint>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+/*!
+  @struct PidConfig
+  @brief PID settings
+  @details Gains are per sample, so the sample rate must be constant (e.g. periodic ADC samples)
+ */
+struct PidConfig {
+    int32_t kp_q16{};                      //!< Proportional gain in Q16.16
+    int32_t ki_q16{};                      //!< Integral gain per sample in Q16.16
+    int32_t kd_q16{};                      //!< Derivative gain per sample in Q16.16
+    int32_t out_min{};                     //!< Lower limit of the output
+    int32_t out_max{};                     //!< Upper limit of the output
+    bool derivative_on_measurement{true};  //!< Derivative of the measurement instead of the error (No kick)
+};
+
+/*!
+  @class Pid
+  @brief PID controller with anti-windup and output limits
+  @details Integer only. The integrator stops while the output is saturated in the direction of the error
+  (conditional integration), and is kept within the output limits
+ */
+class Pid {
+public:
+    Pid() = default;
+
+    //! @brief Gain to Q16.16
+    static constexpr int32_t gain(const float g)
+    {
+        return static_cast<int32_t>(g * 65536.0f + (g >= 0.0f ? 0.5f : -0.5f));
+    }
+
+    //! @brief Gets the settings
+    inline const PidConfig& config() const
+    {
+        return _cfg;
+    }
+    //! @brief Set the settings and reset
+    inline void config(const PidConfig& cfg)
+    {
+        _cfg = cfg;
+        reset();
+    }
+    /*!
+      @brief Reset the state
+      @param output Initial output (For bumpless start, the integrator is preloaded)
+     */
+    void reset(const int32_t output = 0);
+
+    /*!
+      @brief Calculate the output for the sample
+      @param setpoint Setpoint
+      @param measurement Measurement
+      @return Output within the limits
+     */
+    int32_t step(const int32_t setpoint, const int32_t measurement);
+
+    ///@name Properties
+    ///@{
+    //! @brief Gets the last output
+    inline int32_t output() const
+    {
+        return _output;
+    }
+    //! @brief Was the last output limited?
+    inline bool saturated() const
+    {
+        return _saturated;
+    }
+    //! @brief Gets the integral term
+    inline int32_t integral() const
+    {
+        return static_cast<int32_t>(_integral >> 16);
+    }
+    ///@}
+
+private:
+    PidConfig _cfg{};
+    int64_t _integral{};  // Q16
+    int32_t _last_error{}, _last_measurement{};
+    int32_t _output{};
+    bool _first{true}, _saturated{};
+};
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,128 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file playback.cpp
+  @brief Double-buffered arbitrary waveform playback
+*/
+#include "playback.hpp"
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+bool WavePlayer::begin(producer_t producer, output_t output, const size_t buffer_samples,
+                       const uint32_t interval_us)
+{
+    _state = State::Idle;
+    if (!producer || !output || !buffer_samples || !interval_us) {
+        return false;
+    }
+    if (buffer_samples != _capacity) {
+        _capacity = 0;
+        for (auto&& b : _buf) {
+            b.reset(new uint16_t[buffer_samples]);
+            if (!b) {
+                return false;
+            }
+        }
+        _capacity = buffer_samples;
+    }
+    _producer = producer;
+    _output   = output;
+    _interval = interval_us;
+    return true;
+}
+
+bool WavePlayer::start(const uint32_t now_us)
+{
+    _state = State::Idle;
+    if (!_capacity) {
+        return false;
+    }
+    _len[0] = _len[1] = _pos = 0;
+    _active = 0;
+    _eos    = false;
+    _played = _skipped = _failed = _refills = 0;
+
+    // Fill both buffers
+    refill();
+    if (!swap()) {
+        return false;
+    }
+    refill();
+
+    _elapsed = _index = 0;
+    _last_us = now_us;
+    _state   = State::Playing;
+    update(now_us);
+    return true;
+}
+
+void WavePlayer::update(const uint32_t now_us)
+{
+    if (_state != State::Playing) {
+        return;
+    }
+    _elapsed += now_us - _last_us;
+    _last_us = now_us;
+
+    const uint64_t due = _elapsed / _interval;
+    if (due >= _index) {
+        // Skip overdue samples and output the sample due now
+        uint64_t skip = due - _index;
+        while (true) {
+            if (_pos >= _len[_active] && !swap()) {
+                _state = State::Finished;
+                return;
+            }
+            if (!skip) {
+                break;
+            }
+            const size_t n = (skip < _len[_active] - _pos) ? static_cast<size_t>(skip) : _len[_active] - _pos;
+            _pos += n;
+            skip -= n;
+            _skipped += n;
+        }
+        if (_output(_buf[_active][_pos++])) {
+            ++_played;
+        } else {
+            ++_failed;
+        }
+        _index = due + 1;
+    }
+    refill();
+}
+
+// Fill the idle buffer if empty
+void WavePlayer::refill()
+{
+    const uint8_t idle = _active ^ 1;
+    if (_len[idle] || _eos) {
+        return;
+    }
+    size_t n = _producer(_buf[idle].get(), _capacity);
+    ++_refills;
+    _len[idle] = (n < _capacity) ? n : _capacity;
+    _eos       = (n == 0);
+}
+
+// Switch to the idle buffer
+bool WavePlayer::swap()
+{
+    refill();
+    const uint8_t idle = _active ^ 1;
+    if (!_len[idle]) {
+        return false;
+    }
+    _len[_active] = 0;
+    _active       = idle;
+    _pos          = 0;
+    return true;
+}
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
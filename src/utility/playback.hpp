@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file playback.hpp
+  @brief Double-buffered arbitrary waveform playback
+  @details Host buildable, no dependency on M5UnitUnified
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_PLAYBACK_HPP
+#define M5_UNIT_ANADIG_UTILITY_PLAYBACK_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+/*!
+  @class WavePlayer
+  @brief Plays DAC codes supplied by a producer through two buffers
+  @details While one buffer is played, the producer refills the other one.
+  The sample to output is decided by the elapsed time of a monotonic clock, not by the call cadence.
+  If update() is called late, the overdue samples are skipped so that the waveform stays on time
+  @code
+  WavePlayer player;
+  player.begin([](uint16_t* buf, size_t cap) { return read_profile(buf, cap); },  // 0 means end of data
+               [&unit](uint16_t code) { return unit.writeVoltage(code); },     // UnitMCP4725
+               256, 1000);                                                     // 1kHz
+  player.start(m5::utility::micros());
+  // In loop() or a task
+  player.update(m5::utility::micros());
+  @endcode
+ */
+class WavePlayer {
+public:
+    /*!
+      @brief Producer of samples
+      @param buf Buffer to fill
+      @param capacity Capacity of the buffer
+      @return Number of filled samples, 0 if no more data
+     */
+    using producer_t = std::function<size_t(uint16_t* buf, const size_t capacity)>;
+    /*!
+      @brief Output of a sample (e.g. UnitMCP4725::writeVoltage)
+      @return True if successful
+     */
+    using output_t = std::function<bool(const uint16_t code)>;
+
+    //! @brief State
+    enum class State : uint8_t {
+        Idle,      //!< Not started or stopped
+        Playing,   //!< Playing
+        Finished,  //!< All samples are played
+    };
+
+    WavePlayer() = default;
+
+    /*!
+      @brief Set up the player
+      @param producer Producer of samples
+      @param output Output of a sample
+      @param buffer_samples Number of samples of each buffer
+      @param interval_us Sample interval(us)
+      @return True if successful
+     */
+    bool begin(producer_t producer, output_t output, const size_t buffer_samples, const uint32_t interval_us);
+
+    /*!
+      @brief Start playback
+      @param now_us Current time(us) of the monotonic clock
+      @return True if successful
+      @note Both buffers are filled and the first sample is output
+     */
+    bool start(const uint32_t now_us);
+    //! @brief Stop playback
+    inline void stop()
+    {
+        _state = State::Idle;
+    }
+    /*!
+      @brief Output the sample due at the time and refill the idle buffer
+      @param now_us Current time(us) of the monotonic clock
+      @note Call more often than the sample interval
+     */
+    void update(const uint32_t now_us);
+
+    ///@name Properties
+    ///@{
+    //! @brief Gets the state
+    inline State state() const
+    {
+        return _state;
+    }
+    //! @brief Is playing?
+    inline bool playing() const
+    {
+        return _state == State::Playing;
+    }
+    //! @brief Gets the sample interval(us)
+    inline uint32_t interval() const
+    {
+        return _interval;
+    }
+    ///@}
+
+    ///@name Statistics
+    ///@{
+    //! @brief Number of output samples
+    inline uint32_t played() const
+    {
+        return _played;
+    }
+    //! @brief Number of samples skipped because update() was late
+    inline uint32_t skipped() const
+    {
+        return _skipped;
+    }
+    //! @brief Number of failed outputs
+    inline uint32_t failed() const
+    {
+        return _failed;
+    }
+    //! @brief Number of producer calls
+    inline uint32_t refills() const
+    {
+        return _refills;
+    }
+    ///@}
+
+private:
+    void refill();
+    bool swap();
+
+    producer_t _producer{};
+    output_t _output{};
+    std::unique_ptr<uint16_t[]> _buf[2]{};
+    size_t _capacity{}, _len[2]{}, _pos{};
+    uint8_t _active{};
+    bool _eos{};
+    State _state{State::Idle};
+    uint32_t _interval{}, _last_us{};
+    uint64_t _elapsed{}, _index{};
+    uint32_t _played{}, _skipped{}, _failed{}, _refills{};
+};
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,109 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file ramp.hpp
+  @brief Slew-rate-limited ramp generator
+  @details Host buildable, no dependency on M5UnitUnified
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_RAMP_HPP
+#define M5_UNIT_ANADIG_UTILITY_RAMP_HPP
+
+#include <cstdint>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+/*!
+  @class Ramp
+  @brief Moves a voltage to the target at a limited slew rate
+  @details The position is calculated from the elapsed time, so it does not depend on the call cadence.
+  With S-curve (smoothstep), the duration is 1.5 times longer so that the peak slope equals the slew rate
+  @note Integer only
+ */
+class Ramp {
+public:
+    /*!
+      @brief Start the ramp
+      @param from_uv Start voltage(uV)
+      @param to_uv Target voltage(uV)
+      @param rate_mv_per_s Slew rate(mV/s). If zero, the target is reached immediately
+      @param s_curve Use S-curve if true
+      @param now_us Current time(us)
+     */
+    inline void start(const int32_t from_uv, const int32_t to_uv, const uint32_t rate_mv_per_s, const bool s_curve,
+                      const uint32_t now_us)
+    {
+        const int64_t delta   = static_cast<int64_t>(to_uv) - from_uv;
+        const uint64_t mag    = static_cast<uint64_t>(delta < 0 ? -delta : delta);
+        const uint64_t scaled = mag * 1000U * (s_curve ? 3U : 2U) / 2U;  // x1.5 for S-curve
+        _from                 = from_uv;
+        _to                   = to_uv;
+        _s_curve              = s_curve;
+        _duration             = rate_mv_per_s ? (scaled + rate_mv_per_s - 1) / rate_mv_per_s : 0;
+        _elapsed              = 0;
+        _last_us              = now_us;
+        _active               = true;
+    }
+    //! @brief Stop the ramp at the current position
+    inline void stop()
+    {
+        _active = false;
+    }
+    //! @brief Is ramping?
+    inline bool active() const
+    {
+        return _active;
+    }
+    //! @brief Gets the target(uV)
+    inline int32_t target() const
+    {
+        return _to;
+    }
+    //! @brief Gets the duration(us)
+    inline uint64_t duration() const
+    {
+        return _duration;
+    }
+
+    /*!
+      @brief Gets the position at the time
+      @param now_us Current time(us)
+      @return Voltage(uV)
+      @note Becomes inactive when the target is reached
+     */
+    inline int32_t update(const uint32_t now_us)
+    {
+        if (!_active) {
+            return _to;
+        }
+        _elapsed += now_us - _last_us;
+        _last_us = now_us;
+        if (_elapsed >= _duration) {
+            _active = false;
+            return _to;
+        }
+        // Progress in Q16
+        int64_t u = static_cast<int64_t>((_elapsed << 16) / _duration);
+        if (_s_curve) {
+            const int64_t u2 = (u * u) >> 16;
+            const int64_t u3 = (u2 * u) >> 16;
+            u                = 3 * u2 - 2 * u3;
+        }
+        return static_cast<int32_t>(_from + (((static_cast<int64_t>(_to) - _from) * u) >> 16));
+    }
+
+private:
+    int32_t _from{}, _to{};
+    bool _s_curve{}, _active{};
+    uint32_t _last_us{};
+    uint64_t _duration{}, _elapsed{};
+};
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
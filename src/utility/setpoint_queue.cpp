@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file setpoint_queue.cpp
+  @brief Time-tagged DAC setpoint queue
+*/
+#include "setpoint_queue.hpp"
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+bool SetpointQueue::begin(const size_t capacity, const uint32_t tolerance_us)
+{
+    clear();
+    resetStatistics();
+    _tolerance = tolerance_us;
+    if (!capacity) {
+        return false;
+    }
+    if (capacity != _capacity) {
+        _capacity = 0;
+        _buf.reset(new Setpoint[capacity]);
+        if (!_buf) {
+            return false;
+        }
+        _capacity = capacity;
+    }
+    return true;
+}
+
+bool SetpointQueue::push(const uint32_t at_us, const uint8_t channel, const uint16_t code)
+{
+    // Must not be earlier than the last one (wraparound safe)
+    if (full() || (_size && (int32_t)(at_us - at(_size - 1).at_us) < 0)) {
+        ++_rejected;
+        return false;
+    }
+    _buf[(_head + _size) % _capacity] = Setpoint{at_us, channel, code};
+    ++_size;
+    return true;
+}
+
+bool SetpointQueue::next(uint32_t& at_us) const
+{
+    if (_size) {
+        at_us = at(0).at_us;
+        return true;
+    }
+    return false;
+}
+
+size_t SetpointQueue::dispatch(const uint32_t now_us, const output_t& output)
+{
+    return dispatch(now_us, output, commit_t{});
+}
+
+size_t SetpointQueue::dispatch(const uint32_t now_us, const output_t& stage, const commit_t& commit)
+{
+    size_t due{};
+    while (due < _size && (int32_t)(now_us - at(due).at_us) >= 0) {
+        ++due;
+    }
+
+    size_t count{};
+    uint32_t late{}, max_lateness{};
+    uint64_t sum_lateness{};
+    for (size_t i = 0; i < due; ++i) {
+        const Setpoint& sp = at(i);
+        // Skip if a newer one of the same channel is also due
+        bool newer{};
+        for (size_t j = i + 1; j < due && !newer; ++j) {
+            newer = (at(j).channel == sp.channel);
+        }
+        if (newer) {
+            ++_skipped;
+            continue;
+        }
+        if (!stage || !stage(sp.channel, sp.code)) {
+            ++_failed;
+            continue;
+        }
+        const uint32_t lateness = (uint32_t)(now_us - sp.at_us);
+        sum_lateness += lateness;
+        max_lateness = (lateness > max_lateness) ? lateness : max_lateness;
+        late += (lateness > _tolerance);
+        ++count;
+    }
+    _head = (_head + due) % (_capacity ? _capacity : 1);
+    _size -= due;
+
+    if (count && commit && !commit()) {
+        _failed += count;
+        return 0;
+    }
+    _sum_lateness += sum_lateness;
+    _max_lateness = (max_lateness > _max_lateness) ? max_lateness : _max_lateness;
+    _late += late;
+    _issued += count;
+    return count;
+}
+
+void SetpointQueue::resetStatistics()
+{
+    _issued = _skipped = _failed = _rejected = _late = _max_lateness = 0;
+    _sum_lateness = 0;
+}
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
@@ -0,0 +1,195 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file setpoint_queue.hpp
+  @brief Time-tagged DAC setpoint queue
+  @details Host buildable, no dependency on M5UnitUnified
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_SETPOINT_QUEUE_HPP
+#define M5_UNIT_ANADIG_UTILITY_SETPOINT_QUEUE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+/*!
+  @struct Setpoint
+  @brief Code to output at the time
+ */
+struct Setpoint {
+    uint32_t at_us;   //!< Deadline(us) of the monotonic clock
+    uint8_t channel;  //!< Channel
+    uint16_t code;    //!< DAC code
+};
+
+/*!
+  @class SetpointQueue
+  @brief Issues precomputed setpoints at their deadlines
+  @details Setpoints must be pushed in order of time.
+  All setpoints due at the time are issued at once. If several setpoints of the same channel are due,
+  only the latest one is issued and the others are counted as skipped.
+  Lateness (the time from the deadline to the issue) is recorded for the statistics
+  @code
+  SetpointQueue& q = unit.setpointQueue();  // UnitMCP4725 or UnitGP8413
+  q.begin(64);
+  auto t = m5::utility::micros() + 10000;
+  for (auto&& code : profile) {
+      q.push(t, 0, code);
+      t += 1000;
+  }
+  // In loop() or a task
+  unit.update();
+  @endcode
+ */
+class SetpointQueue {
+public:
+    /*!
+      @brief Output of a setpoint
+      @return True if successful
+     */
+    using output_t = std::function<bool(const uint8_t channel, const uint16_t code)>;
+    /*!
+      @brief Output of the staged setpoints at once
+      @return True if successful
+     */
+    using commit_t = std::function<bool()>;
+
+    SetpointQueue() = default;
+
+    /*!
+      @brief Allocate the queue
+      @param capacity Maximum number of setpoints
+      @param tolerance_us Lateness(us) exceeding this is counted as late
+      @return True if successful
+      @note The queue and the statistics are cleared
+     */
+    bool begin(const size_t capacity, const uint32_t tolerance_us = 1000);
+
+    /*!
+      @brief Push a setpoint
+      @param at_us Deadline(us)
+      @param channel Channel
+      @param code DAC code
+      @return True if successful, false if full or earlier than the last pushed one
+     */
+    bool push(const uint32_t at_us, const uint8_t channel, const uint16_t code);
+    //! @brief Remove all setpoints
+    inline void clear()
+    {
+        _head = _size = 0;
+    }
+    /*!
+      @brief Gets the deadline of the next setpoint
+      @param[out] at_us Deadline(us)
+      @return True if exists
+      @note For a task to sleep until the deadline
+     */
+    bool next(uint32_t& at_us) const;
+
+    /*!
+      @brief Issue the setpoints due at the time
+      @param now_us Current time(us) of the monotonic clock
+      @param output Output function
+      @return Number of issued setpoints
+     */
+    size_t dispatch(const uint32_t now_us, const output_t& output);
+    /*!
+      @brief Issue the setpoints due at the time in one transaction
+      @param now_us Current time(us) of the monotonic clock
+      @param stage Stages the output of a setpoint (e.g. into the frame of the multi-channel write)
+      @param commit Outputs the staged setpoints at once (Called if any setpoint is staged)
+      @return Number of issued setpoints
+      @note If commit fails, the staged setpoints are counted as failed
+     */
+    size_t dispatch(const uint32_t now_us, const output_t& stage, const commit_t& commit);
+
+    ///@name Properties
+    ///@{
+    //! @brief Number of queued setpoints
+    inline size_t size() const
+    {
+        return _size;
+    }
+    //! @brief Gets the capacity
+    inline size_t capacity() const
+    {
+        return _capacity;
+    }
+    //! @brief Is empty?
+    inline bool empty() const
+    {
+        return !_size;
+    }
+    //! @brief Is full?
+    inline bool full() const
+    {
+        return _size >= _capacity;
+    }
+    ///@}
+
+    ///@name Statistics
+    ///@{
+    //! @brief Number of issued setpoints
+    inline uint32_t issued() const
+    {
+        return _issued;
+    }
+    //! @brief Number of setpoints skipped because a newer one of the same channel was also due
+    inline uint32_t skipped() const
+    {
+        return _skipped;
+    }
+    //! @brief Number of failed outputs
+    inline uint32_t failed() const
+    {
+        return _failed;
+    }
+    //! @brief Number of rejected pushes
+    inline uint32_t rejected() const
+    {
+        return _rejected;
+    }
+    //! @brief Number of issued setpoints later than the tolerance
+    inline uint32_t late() const
+    {
+        return _late;
+    }
+    //! @brief Maximum lateness(us)
+    inline uint32_t maxLateness() const
+    {
+        return _max_lateness;
+    }
+    //! @brief Mean lateness(us)
+    inline uint32_t meanLateness() const
+    {
+        return _issued ? static_cast<uint32_t>(_sum_lateness / _issued) : 0;
+    }
+    //! @brief Clear the statistics
+    void resetStatistics();
+    ///@}
+
+private:
+    inline const Setpoint& at(const size_t idx) const
+    {
+        return _buf[(_head + idx) % _capacity];
+    }
+
+    std::unique_ptr<Setpoint[]> _buf{};
+    size_t _capacity{}, _head{}, _size{};
+    uint32_t _tolerance{};
+    uint32_t _issued{}, _skipped{}, _failed{}, _rejected{}, _late{}, _max_lateness{};
+    uint64_t _sum_lateness{};
+};
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,222 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file spectrum.cpp
+  @brief Block FFT spectral analysis of ADC windows
+*/
+#include "spectrum.hpp"
+#include "fixed_point.hpp"
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace {
+
+constexpr double PI{3.14159265358979323846};
+
+int16_t to_q15(const double v)
+{
+    const long q = std::lround(v * 32768.0);
+    return static_cast<int16_t>(q > 32767 ? 32767 : q < -32768 ? -32768 : q);
+}
+
+double window_value(const m5::unit::anadig::Window w, const uint32_t n, const uint32_t size)
+{
+    const double x = 2.0 * PI * n / size;  // Periodic window
+    switch (w) {
+        case m5::unit::anadig::Window::Hann:
+            return 0.5 - 0.5 * std::cos(x);
+        case m5::unit::anadig::Window::BlackmanHarris:
+            return 0.35875 - 0.48829 * std::cos(x) + 0.14128 * std::cos(2 * x) - 0.01168 * std::cos(3 * x);
+        default:
+            return 1.0;
+    }
+}
+
+// Frequency aliased into [0, sample_rate / 2]
+double alias(const double sample_rate, const double freq)
+{
+    const double f = std::fmod(freq, sample_rate);
+    return (f > sample_rate * 0.5) ? sample_rate - f : f;
+}
+
+float to_db(const double signal, const double noise)
+{
+    return (noise > 0.0) ? static_cast<float>(10.0 * std::log10(signal / noise))
+                         : std::numeric_limits<float>::infinity();
+}
+
+}  // namespace
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+constexpr uint16_t Spectrum::MIN_SIZE;
+constexpr uint16_t Spectrum::MAX_SIZE;
+
+bool Spectrum::begin(const uint16_t size, const Window window)
+{
+    _size = 0;
+    if (size < MIN_SIZE || size > MAX_SIZE || (size & (size - 1))) {
+        return false;
+    }
+    _window.reset(new int16_t[size]);
+    _twiddle.reset(new int16_t[size]);
+    _re.reset(new int32_t[size]);
+    _im.reset(new int32_t[size]);
+    _mag.reset(new uint32_t[size / 2 + 1]);
+    if (!_window || !_twiddle || !_re || !_im || !_mag) {
+        return false;
+    }
+
+    double sum{}, power{};
+    for (uint32_t n = 0; n < size; ++n) {
+        const double w = window_value(window, n, size);
+        _window[n]     = to_q15(w);
+        sum += w;
+        power += w * w;
+    }
+    for (uint32_t k = 0; k < size / 2; ++k) {
+        _twiddle[k]            = to_q15(std::cos(2.0 * PI * k / size));
+        _twiddle[size / 2 + k] = to_q15(std::sin(2.0 * PI * k / size));
+    }
+    // Half width(bins) of the main lobe
+    _lobe      = (window == Window::BlackmanHarris) ? 4 : (window == Window::Hann) ? 2 : 1;
+    _cg_q15    = static_cast<uint32_t>(std::lround(sum / size * 32768.0));
+    _power_sum = power;
+    _size      = size;
+    _result    = SpectrumResult{};
+    return true;
+}
+
+bool Spectrum::analyze(sample_t sample, const size_t num, const float sample_rate)
+{
+    if (!_size || !sample || num < _size || sample_rate <= 0.0f) {
+        return false;
+    }
+    // Windowed input in Q8
+    const size_t first = num - _size;
+    for (uint32_t n = 0; n < _size; ++n) {
+        _re[n] = (static_cast<int32_t>(sample(first + n)) * _window[n]) >> 7;
+        _im[n] = 0;
+    }
+    _sample_rate = sample_rate;
+    fft();
+
+    // Peak amplitude corrected by the coherent gain (DC and Nyquist are not doubled)
+    const uint16_t half = _size / 2;
+    for (uint32_t k = 0; k <= half; ++k) {
+        const uint64_t p = static_cast<uint64_t>(static_cast<int64_t>(_re[k]) * _re[k]) +
+                           static_cast<uint64_t>(static_cast<int64_t>(_im[k]) * _im[k]);
+        const uint64_t m = static_cast<uint64_t>(isqrt(p)) << ((k == 0 || k == half) ? 15 : 16);
+        _mag[k]          = static_cast<uint32_t>(m / _cg_q15);
+    }
+    estimate();
+    return true;
+}
+
+bool Spectrum::analyze(const int16_t* samples, const size_t num, const float sample_rate)
+{
+    return samples && analyze([samples](const size_t idx) { return samples[idx]; }, num, sample_rate);
+}
+
+// Radix-2 DIT, scaled by 1/size
+void Spectrum::fft()
+{
+    for (uint32_t i = 1, j = 0; i < _size; ++i) {
+        uint32_t bit = _size >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(_re[i], _re[j]);
+        }
+    }
+
+    const int16_t* cos_t = _twiddle.get();
+    const int16_t* sin_t = _twiddle.get() + _size / 2;
+    for (uint32_t len = 2; len <= _size; len <<= 1) {
+        const uint32_t half = len >> 1;
+        const uint32_t step = _size / len;
+        for (uint32_t i = 0; i < _size; i += len) {
+            for (uint32_t j = 0; j < half; ++j) {
+                // W = cos - j sin
+                const int64_t wr = cos_t[j * step];
+                const int64_t wi = -sin_t[j * step];
+                int32_t& ar      = _re[i + j];
+                int32_t& ai      = _im[i + j];
+                int32_t& br      = _re[i + j + half];
+                int32_t& bi      = _im[i + j + half];
+                const int32_t tr = static_cast<int32_t>((br * wr - bi * wi) >> 15);
+                const int32_t ti = static_cast<int32_t>((br * wi + bi * wr) >> 15);
+                br               = (ar - tr) >> 1;
+                bi               = (ai - ti) >> 1;
+                ar               = (ar + tr) >> 1;
+                ai               = (ai + ti) >> 1;
+            }
+        }
+    }
+}
+
+void Spectrum::estimate()
+{
+    const uint16_t half = _size / 2;
+    auto power          = [this, half](const uint32_t k) {
+        const double p = static_cast<double>(_re[k]) * _re[k] + static_cast<double>(_im[k]) * _im[k];
+        return (k == 0 || k == half) ? p : 2.0 * p;  // One-sided
+    };
+
+    SpectrumResult r{};
+    r.dc = static_cast<int32_t>((static_cast<int64_t>(_re[0]) << 15) / static_cast<int64_t>(_cg_q15));
+
+    // Dominant bin out of the DC lobe
+    uint32_t peak = _lobe;
+    for (uint32_t k = _lobe; k <= half; ++k) {
+        peak = (power(k) > power(peak)) ? k : peak;
+    }
+    double delta{};
+    if (peak > 0 && peak < half) {
+        const double l = std::sqrt(power(peak - 1)), c = std::sqrt(power(peak)), h = std::sqrt(power(peak + 1));
+        const double d = 2.0 * c - l - h;
+        delta          = (d > 0.0) ? 0.5 * (h - l) / d : 0.0;
+    }
+    r.dominant_hz = static_cast<float>((peak + delta) * _sample_rate / _size);
+
+    // Signal, harmonics and noise out of the DC lobe
+    const auto in_lobe = [this](const uint32_t k, const uint32_t center) {
+        return k + _lobe >= center && k <= center + _lobe;
+    };
+    uint32_t harmonic[4]{};
+    for (uint32_t h = 0; h < 4; ++h) {
+        harmonic[h] = static_cast<uint32_t>(
+            std::lround(alias(_sample_rate, r.dominant_hz * (h + 2)) * _size / _sample_rate));
+    }
+    double signal{}, distortion{}, noise{};
+    for (uint32_t k = _lobe; k <= half; ++k) {
+        const double p = power(k);
+        if (in_lobe(k, peak)) {
+            signal += p;
+            continue;
+        }
+        bool is_harmonic{};
+        for (auto&& hk : harmonic) {
+            is_harmonic |= (hk >= _lobe) && in_lobe(k, hk);
+        }
+        (is_harmonic ? distortion : noise) += p;
+    }
+    // Peak amplitude from the power of the main lobe (Robust against scalloping)
+    r.dominant = static_cast<uint32_t>(std::lround(std::sqrt(2.0 * signal * _size / _power_sum)));
+    r.snr      = to_db(signal, noise);
+    r.sinad    = to_db(signal, noise + distortion);
+    r.enob     = (r.sinad - 1.76f) / 6.02f;
+    _result    = r;
+}
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
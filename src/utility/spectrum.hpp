@@ -0,0 +1,133 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file spectrum.hpp
+  @brief Block FFT spectral analysis of ADC windows
+  @details Host buildable, no dependency on M5UnitUnified
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_SPECTRUM_HPP
+#define M5_UNIT_ANADIG_UTILITY_SPECTRUM_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+//! @brief Window function
+enum class Window : uint8_t {
+    Rectangular,     //!< No window (Coherent sampling only)
+    Hann,            //!< Hann
+    BlackmanHarris,  //!< 4-term Blackman-Harris (Low leakage for SNR/ENOB)
+};
+
+/*!
+  @struct SpectrumResult
+  @brief Estimates from the spectrum
+ */
+struct SpectrumResult {
+    float dominant_hz{};  //!< Frequency(Hz) of the dominant component (Interpolated)
+    uint32_t dominant{};  //!< Peak amplitude of the dominant component (Raw value in Q8)
+    int32_t dc{};         //!< DC (Raw value in Q8)
+    float snr{};          //!< SNR(dB) excluding the harmonics up to the 5th
+    float sinad{};        //!< SINAD(dB)
+    float enob{};         //!< ENOB(bits) from SINAD
+};
+
+/*!
+  @class Spectrum
+  @brief Windowed in-place fixed-point FFT with the magnitude spectrum
+  @details Radix-2 with Q15 twiddles, scaled by 1/2 at each stage so that it never overflows.
+  The magnitude of each bin is the peak amplitude of a sine in the raw value (Q8).
+  The estimates are calculated in floating point from the spectrum
+  @code
+  Spectrum spectrum;
+  spectrum.begin(256, Window::BlackmanHarris);
+  if (spectrum.analyze(samples, num, 240.f)) {  // The last 256 samples
+      auto& r = spectrum.result();
+  }
+  @endcode
+ */
+class Spectrum {
+public:
+    static constexpr uint16_t MIN_SIZE{8};     //!< Minimum FFT size
+    static constexpr uint16_t MAX_SIZE{1024};  //!< Maximum FFT size
+
+    //! @brief Gets the sample at the index (0: Oldest)
+    using sample_t = std::function<int16_t(const size_t idx)>;
+
+    Spectrum() = default;
+
+    /*!
+      @brief Set up the analyzer
+      @param size FFT size (Power of 2, MIN_SIZE - MAX_SIZE)
+      @param window Window function
+      @return True if successful
+     */
+    bool begin(const uint16_t size, const Window window = Window::Hann);
+
+    /*!
+      @brief Analyze the last size() samples
+      @param sample Sample accessor
+      @param num Number of samples (At least size())
+      @param sample_rate Sampling rate(Hz)
+      @return True if successful
+     */
+    bool analyze(sample_t sample, const size_t num, const float sample_rate);
+    //! @brief Analyze the last size() samples of the array
+    bool analyze(const int16_t* samples, const size_t num, const float sample_rate);
+
+    ///@name Properties
+    ///@{
+    //! @brief FFT size
+    inline uint16_t size() const
+    {
+        return _size;
+    }
+    //! @brief Number of bins (size() / 2 + 1)
+    inline uint16_t bins() const
+    {
+        return _size ? _size / 2 + 1 : 0;
+    }
+    //! @brief Peak amplitude of each bin (Raw value in Q8, Valid if analyzed)
+    inline const uint32_t* magnitude() const
+    {
+        return _mag.get();
+    }
+    //! @brief Frequency(Hz) of the bin
+    inline float frequency(const uint16_t bin) const
+    {
+        return _size ? bin * _sample_rate / _size : 0.0f;
+    }
+    //! @brief Gets the estimates (Valid if analyzed)
+    inline const SpectrumResult& result() const
+    {
+        return _result;
+    }
+    ///@}
+
+private:
+    void fft();
+    void estimate();
+
+    uint16_t _size{};
+    uint8_t _lobe{};
+    uint32_t _cg_q15{};   // Coherent gain
+    double _power_sum{};  // Sum of squared window
+    float _sample_rate{};
+    std::unique_ptr<int16_t[]> _window{}, _twiddle{};  // twiddle: cos[size/2] sin[size/2]
+    std::unique_ptr<int32_t[]> _re{}, _im{};
+    std::unique_ptr<uint32_t[]> _mag{};
+    SpectrumResult _result{};
+};
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,232 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file stream_codec.cpp
+  @brief Compact delta/varint binary format for ADC sample streams
+*/
+#include "stream_codec.hpp"
+#include <cstring>
+
+using namespace m5::unit::anadig::codec;
+
+namespace {
+void put_u32(uint8_t* p, const uint32_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = (v >> 24) & 0xFF;
+}
+
+uint32_t get_u32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void put_f32(uint8_t* p, const float f)
+{
+    uint32_t v{};
+    std::memcpy(&v, &f, sizeof(v));
+    put_u32(p, v);
+}
+
+float get_f32(const uint8_t* p)
+{
+    uint32_t v = get_u32(p);
+    float f{};
+    std::memcpy(&f, &v, sizeof(f));
+    return f;
+}
+
+}  // namespace
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+constexpr size_t StreamEncoder::HEADER_RESERVED;
+constexpr size_t StreamEncoder::MAX_SAMPLE_SIZE;
+
+// --------------------------------
+// StreamEncoder
+StreamEncoder::StreamEncoder(sink_t sink, const bool timestamp, const uint16_t block_samples)
+    : _sink(sink), _timestamp{timestamp}, _block_samples{block_samples ? block_samples : (uint16_t)1}
+{
+    _buf.reset(new uint8_t[HEADER_RESERVED + _block_samples * MAX_SAMPLE_SIZE]);
+}
+
+bool StreamEncoder::begin()
+{
+    _len       = _count = 0;
+    _has_epoch = false;
+    _samples   = _bytes = 0;
+    return write(MAGIC, sizeof(MAGIC));
+}
+
+bool StreamEncoder::push(const StreamEpoch& epoch, const int16_t value, const uint32_t ms)
+{
+    if (!_has_epoch || epoch != _epoch) {
+        if (!flush() || !write_epoch(epoch)) {
+            return false;
+        }
+    }
+
+    uint8_t* p = _buf.get() + HEADER_RESERVED + _len;
+    size_t n   = write_varint(p, zigzag(static_cast<int32_t>(value) - _prev));
+    if (_timestamp) {
+        n += write_varint(p + n, ms - _prev_ms);
+        _prev_ms = ms;
+    }
+    _prev = value;
+    _len += n;
+    ++_samples;
+    return (++_count >= _block_samples) ? flush() : true;
+}
+
+bool StreamEncoder::flush()
+{
+    if (!_count) {
+        return true;
+    }
+    uint8_t hdr[HEADER_RESERVED]{};
+    hdr[0]       = TAG_BLOCK;
+    size_t hlen  = 1 + write_varint(hdr + 1, _count);
+    uint8_t* top = _buf.get() + HEADER_RESERVED - hlen;
+    std::memcpy(top, hdr, hlen);
+
+    size_t len = hlen + _len;
+    _len = _count = 0;
+    return write(top, len);
+}
+
+bool StreamEncoder::write(const uint8_t* buf, const size_t len)
+{
+    if (!_sink || _sink(buf, len) != len) {
+        return false;
+    }
+    _bytes += len;
+    return true;
+}
+
+bool StreamEncoder::write_epoch(const StreamEpoch& e)
+{
+    uint8_t buf[EPOCH_SIZE]{TAG_EPOCH, (uint8_t)(_timestamp ? FLAG_TIMESTAMP : 0), e.rate, e.pga};
+    put_f32(buf + 4, e.vdd);
+    put_f32(buf + 8, e.factor);
+    put_u32(buf + 12, e.lsb_q16);
+    if (write(buf, sizeof(buf))) {
+        _epoch     = e;
+        _has_epoch = true;
+        _prev      = 0;
+        _prev_ms   = 0;
+        return true;
+    }
+    return false;
+}
+
+// --------------------------------
+// StreamDecoder
+void StreamDecoder::reset()
+{
+    _state   = State::Magic;
+    _idx     = 0;
+    _flags   = 0;
+    _acc     = _shift = 0;
+    _samples = 0;
+}
+
+bool StreamDecoder::feed(const uint8_t* buf, const size_t len)
+{
+    if (!buf) {
+        return false;
+    }
+    for (size_t i = 0; i < len && _state != State::Error; ++i) {
+        const uint8_t b = buf[i];
+        switch (_state) {
+            case State::Magic:
+                if (b != MAGIC[_idx]) {
+                    _state = State::Error;
+                } else if (++_idx >= sizeof(MAGIC)) {
+                    _state = State::Tag;
+                }
+                break;
+            case State::Tag:
+                _idx   = 0;
+                _state = (b == TAG_EPOCH) ? State::Epoch : (b == TAG_BLOCK) ? State::Count : State::Error;
+                break;
+            case State::Epoch:
+                _ebuf[_idx++] = b;
+                if (_idx >= sizeof(_ebuf)) {
+                    _flags         = _ebuf[0];
+                    _epoch.rate    = _ebuf[1];
+                    _epoch.pga     = _ebuf[2];
+                    _epoch.vdd     = get_f32(_ebuf + 3);
+                    _epoch.factor  = get_f32(_ebuf + 7);
+                    _epoch.lsb_q16 = get_u32(_ebuf + 11);
+                    _value         = 0;
+                    _ms            = 0;
+                    _state         = State::Tag;
+                }
+                break;
+            case State::Count:
+                if (feed_varint(b)) {
+                    _remain = _var;
+                    _state  = _remain ? State::Value : State::Tag;
+                }
+                break;
+            case State::Value:
+                if (feed_varint(b)) {
+                    _value = static_cast<int16_t>(_value + unzigzag(_var));
+                    if (hasTimestamp()) {
+                        _state = State::Time;
+                    } else {
+                        emit();
+                    }
+                }
+                break;
+            case State::Time:
+                if (feed_varint(b)) {
+                    _ms += _var;
+                    emit();
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return !error();
+}
+
+// Return true if varint completed (Result in _var)
+bool StreamDecoder::feed_varint(const uint8_t b)
+{
+    if (_shift > 28) {
+        _state = State::Error;
+        return false;
+    }
+    _acc |= static_cast<uint32_t>(b & 0x7F) << _shift;
+    _shift += 7;
+    if (b & 0x80) {
+        return false;
+    }
+    _var   = _acc;
+    _acc   = 0;
+    _shift = 0;
+    return true;
+}
+
+void StreamDecoder::emit()
+{
+    ++_samples;
+    if (_callback) {
+        _callback(_epoch, _value, _ms);
+    }
+    _state = (--_remain) ? State::Value : State::Tag;
+}
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
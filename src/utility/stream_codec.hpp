@@ -0,0 +1,247 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file stream_codec.hpp
+  @brief Compact delta/varint binary format for ADC sample streams
+  @details Host buildable, no dependency on M5UnitUnified
+
+  Format (Multi-byte fixed values are little endian)
+  @verbatim
+  Stream := Magic Record*
+  Magic  := 'A' 'D' 'Z' 0x01
+  Record := Epoch | Block
+  Epoch  := 0xE0 flags(u8) rate(u8) pga(u8) vdd(f32) factor(f32) lsb_q16(u32)
+  Block  := 0xB0 count(varint) Sample{count}
+  Sample := zigzag_varint(value - previous value) [varint(time - previous time) if flags bit0]
+  @endverbatim
+  Previous value and time are reset to zero by each Epoch.
+  A sample costs 1-3 bytes (+1-5 bytes with timestamp) instead of a text line
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_STREAM_CODEC_HPP
+#define M5_UNIT_ANADIG_UTILITY_STREAM_CODEC_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+/*!
+  @namespace codec
+  @brief Constants and primitives of the stream format
+ */
+namespace codec {
+constexpr uint8_t MAGIC[4] = {'A', 'D', 'Z', 0x01};  //!< Stream magic and version
+constexpr uint8_t TAG_EPOCH{0xE0};                   //!< Epoch record
+constexpr uint8_t TAG_BLOCK{0xB0};                   //!< Block record
+constexpr uint8_t FLAG_TIMESTAMP{0x01};              //!< Samples have timestamp
+constexpr size_t EPOCH_SIZE{16};                     //!< Size of the epoch record
+
+//! @brief Zigzag encode
+inline uint32_t zigzag(const int32_t v)
+{
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+//! @brief Zigzag decode
+inline int32_t unzigzag(const uint32_t v)
+{
+    return static_cast<int32_t>(v >> 1) ^ -static_cast<int32_t>(v & 1);
+}
+/*!
+  @brief Write the varint
+  @return Number of bytes written (1-5)
+ */
+inline size_t write_varint(uint8_t* p, uint32_t v)
+{
+    size_t n{};
+    while (v >= 0x80) {
+        p[n++] = static_cast<uint8_t>(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = static_cast<uint8_t>(v);
+    return n;
+}
+}  // namespace codec
+
+/*!
+  @struct StreamEpoch
+  @brief Conversion settings shared by following samples
+ */
+struct StreamEpoch {
+    uint8_t rate{};      //!< Rate value
+    uint8_t pga{};       //!< PGA value
+    float vdd{};         //!< VDD(mV)
+    float factor{};      //!< Correction factor
+    uint32_t lsb_q16{};  //!< Voltage(uV) per LSB in Q16.16
+
+    inline bool operator==(const StreamEpoch& o) const
+    {
+        return rate == o.rate && pga == o.pga && vdd == o.vdd && factor == o.factor && lsb_q16 == o.lsb_q16;
+    }
+    inline bool operator!=(const StreamEpoch& o) const
+    {
+        return !(*this == o);
+    }
+};
+
+/*!
+  @class StreamEncoder
+  @brief Encoder of the stream format
+  @details Samples are buffered and each block is written by a single sink call
+ */
+class StreamEncoder {
+public:
+    /*!
+      @brief Sink of encoded bytes
+      @return Number of bytes written
+      @note For example, Arduino Stream::write or fwrite
+     */
+    using sink_t = std::function<size_t(const uint8_t* buf, const size_t len)>;
+
+    /*!
+      @param sink Sink of encoded bytes
+      @param timestamp Encode timestamp if true
+      @param block_samples Maximum number of samples in a block
+     */
+    explicit StreamEncoder(sink_t sink, const bool timestamp = false, const uint16_t block_samples = 64);
+
+    //! @brief Write the magic. Must be called first
+    bool begin();
+    /*!
+      @brief Push the sample
+      @param epoch Conversion settings of the sample
+      @param value Raw value
+      @param ms Timestamp(ms) (Ignored if timestamp is disabled)
+      @return True if successful
+      @note Epoch record is written if epoch changed
+     */
+    bool push(const StreamEpoch& epoch, const int16_t value, const uint32_t ms = 0);
+    /*!
+      @brief Push the measurement data
+      @tparam D Data type like ads11xx::Data
+     */
+    template <class D>
+    inline bool push(const D& d, const uint32_t ms = 0)
+    {
+        StreamEpoch e{};
+        e.rate    = d.rate;
+        e.pga     = static_cast<uint8_t>(d.pga);
+        e.vdd     = d.vdd;
+        e.factor  = d.factor;
+        e.lsb_q16 = d.lsb_q16;
+        return push(e, d.differentialValue(), ms);
+    }
+    //! @brief Write the buffered block
+    bool flush();
+
+    ///@name Statistics
+    ///@{
+    //! @brief Number of encoded samples
+    inline uint32_t samples() const
+    {
+        return _samples;
+    }
+    //! @brief Number of bytes written to the sink
+    inline uint32_t bytes() const
+    {
+        return _bytes;
+    }
+    ///@}
+
+private:
+    static constexpr size_t HEADER_RESERVED{4};  // tag + count(varint up to 3 bytes)
+    static constexpr size_t MAX_SAMPLE_SIZE{8};  // value(3) + time(5)
+
+    bool write(const uint8_t* buf, const size_t len);
+    bool write_epoch(const StreamEpoch& e);
+
+    sink_t _sink{};
+    bool _timestamp{}, _has_epoch{};
+    uint16_t _block_samples{};
+    std::unique_ptr<uint8_t[]> _buf{};
+    size_t _len{};
+    uint16_t _count{};
+    StreamEpoch _epoch{};
+    int16_t _prev{};
+    uint32_t _prev_ms{};
+    uint32_t _samples{}, _bytes{};
+};
+
+/*!
+  @class StreamDecoder
+  @brief Incremental decoder of the stream format
+  @details Input can be split at any position
+ */
+class StreamDecoder {
+public:
+    /*!
+      @brief Callback for each decoded sample
+      @param epoch Conversion settings of the sample
+      @param value Raw value
+      @param ms Timestamp(ms) (0 if not encoded)
+     */
+    using callback_t = std::function<void(const StreamEpoch& epoch, const int16_t value, const uint32_t ms)>;
+
+    explicit StreamDecoder(callback_t cb) : _callback(cb)
+    {
+    }
+
+    /*!
+      @brief Feed the bytes
+      @return False if the stream is broken (Decoding stops until reset())
+     */
+    bool feed(const uint8_t* buf, const size_t len);
+    //! @brief Reset to the initial state (Expecting the magic)
+    void reset();
+
+    //! @brief Is the stream broken?
+    inline bool error() const
+    {
+        return _state == State::Error;
+    }
+    //! @brief Gets the current epoch
+    inline const StreamEpoch& epoch() const
+    {
+        return _epoch;
+    }
+    //! @brief Has the timestamp?
+    inline bool hasTimestamp() const
+    {
+        return _flags & codec::FLAG_TIMESTAMP;
+    }
+    //! @brief Number of decoded samples
+    inline uint32_t samples() const
+    {
+        return _samples;
+    }
+
+private:
+    enum class State : uint8_t { Magic, Tag, Epoch, Count, Value, Time, Error };
+
+    bool feed_varint(const uint8_t b);
+    void emit();
+
+    callback_t _callback{};
+    State _state{State::Magic};
+    uint8_t _idx{};
+    uint8_t _ebuf[codec::EPOCH_SIZE - 1]{};
+    uint8_t _flags{};
+    StreamEpoch _epoch{};
+    uint32_t _acc{}, _var{};
+    uint8_t _shift{};
+    uint32_t _remain{};
+    int16_t _value{};
+    uint32_t _ms{};
+    uint32_t _samples{};
+};
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
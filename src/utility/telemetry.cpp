@@ -0,0 +1,244 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file telemetry.cpp
+  @brief COBS framed binary telemetry for ADC samples and DAC setpoints
+*/
+#include "telemetry.hpp"
+#include "stream_codec.hpp"
+
+using namespace m5::unit::anadig::telemetry;
+using m5::unit::anadig::codec::write_varint;
+using m5::unit::anadig::codec::zigzag;
+using m5::unit::anadig::codec::unzigzag;
+
+namespace {
+
+// Return false if broken
+bool read_varint(uint32_t& out, const uint8_t*& p, const uint8_t* end)
+{
+    out = 0;
+    for (uint8_t shift = 0; shift <= 28 && p < end; shift += 7) {
+        const uint8_t b = *p++;
+        out |= static_cast<uint32_t>(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+namespace telemetry {
+
+size_t cobs_encode(uint8_t* dst, const uint8_t* src, const size_t len)
+{
+    size_t code_pos{0}, out{1};
+    uint8_t code{1};
+    for (size_t i = 0; i < len; ++i) {
+        if (src[i]) {
+            dst[out++] = src[i];
+            ++code;
+        }
+        if (!src[i] || code == 0xFF) {
+            dst[code_pos] = code;
+            code          = 1;
+            code_pos      = out++;
+        }
+    }
+    dst[code_pos] = code;
+    return out;
+}
+
+// Can be decoded in place (dst == src)
+size_t cobs_decode(uint8_t* dst, const uint8_t* src, const size_t len)
+{
+    size_t in{}, out{};
+    while (in < len) {
+        const uint8_t code = src[in++];
+        if (!code || in + code - 1 > len) {
+            return 0;
+        }
+        for (uint8_t i = 1; i < code; ++i) {
+            dst[out++] = src[in++];
+        }
+        if (code != 0xFF && in < len) {
+            dst[out++] = 0;
+        }
+    }
+    return out;
+}
+
+uint16_t crc16(const uint8_t* p, const size_t len, uint16_t crc)
+{
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= static_cast<uint16_t>(p[i]) << 8;
+        for (uint8_t b = 0; b < 8; ++b) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+}  // namespace telemetry
+
+// --------------------------------
+// TelemetryWriter
+bool TelemetryWriter::push(const Kind kind, const uint8_t source, const uint8_t channel, const int32_t value,
+                           const uint32_t ms)
+{
+    if (_count && _len + MAX_RECORD + CRC_SIZE > MAX_PACKET) {
+        if (!flush()) {
+            return false;
+        }
+    }
+    if (!_count) {
+        _base_ms = ms;
+        _len     = HEADER_SIZE;
+    }
+
+    uint8_t* p = _packet + _len;
+    *p++       = static_cast<uint8_t>((static_cast<uint8_t>(kind) << 4) | (channel & 0x0F));
+    *p++       = source;
+    p += write_varint(p, ms - _base_ms);
+    p += write_varint(p, zigzag(value));
+    _len = p - _packet;
+    ++_count;
+
+    return (_max_latency && ms - _base_ms >= _max_latency) ? flush() : true;
+}
+
+bool TelemetryWriter::update(const uint32_t now_ms)
+{
+    return (_count && _max_latency && now_ms - _base_ms >= _max_latency) ? flush() : true;
+}
+
+bool TelemetryWriter::flush()
+{
+    if (!_count) {
+        return true;
+    }
+    _packet[0] = VERSION;
+    _packet[1] = _seq & 0xFF;
+    _packet[2] = _seq >> 8;
+    _packet[3] = _base_ms & 0xFF;
+    _packet[4] = (_base_ms >> 8) & 0xFF;
+    _packet[5] = (_base_ms >> 16) & 0xFF;
+    _packet[6] = (_base_ms >> 24) & 0xFF;
+    const uint16_t crc = crc16(_packet, _len);
+    _packet[_len++]    = crc & 0xFF;
+    _packet[_len++]    = crc >> 8;
+
+    size_t flen    = cobs_encode(_frame, _packet, _len);
+    _frame[flen++] = 0x00;
+
+    const uint16_t cnt = _count;
+    _count             = 0;
+    _len               = 0;
+    ++_seq;  // Advanced even if failed, so that the reader can count it as lost
+
+    if (!_sink || _sink(_frame, flen) != flen) {
+        ++_failed;
+        return false;
+    }
+    ++_frames;
+    _records += cnt;
+    _bytes += flen;
+    return true;
+}
+
+// --------------------------------
+// TelemetryReader
+void TelemetryReader::reset()
+{
+    _len      = 0;
+    _overflow = _has_seq = false;
+    _frames = _records = _crc_errors = _frame_errors = _lost = 0;
+}
+
+void TelemetryReader::feed(const uint8_t* buf, const size_t len)
+{
+    for (size_t i = 0; buf && i < len; ++i) {
+        const uint8_t b = buf[i];
+        if (b) {
+            if (_len < sizeof(_frame)) {
+                _frame[_len++] = b;
+            } else {
+                _overflow = true;
+            }
+            continue;
+        }
+        // Delimiter
+        if (_overflow) {
+            ++_frame_errors;
+        } else if (_len) {
+            parse_frame();
+        }
+        _len      = 0;
+        _overflow = false;
+    }
+}
+
+void TelemetryReader::parse_frame()
+{
+    size_t plen = cobs_decode(_frame, _frame, _len);
+    if (plen < HEADER_SIZE + CRC_SIZE || _frame[0] != VERSION) {
+        ++_frame_errors;
+        return;
+    }
+    const uint16_t crc = static_cast<uint16_t>(_frame[plen - 2] | (_frame[plen - 1] << 8));
+    if (crc16(_frame, plen - CRC_SIZE) != crc) {
+        ++_crc_errors;
+        return;
+    }
+    if (!parse_packet(_frame, plen - CRC_SIZE)) {
+        ++_frame_errors;
+    }
+}
+
+bool TelemetryReader::parse_packet(const uint8_t* p, const size_t len)
+{
+    const uint8_t* end = p + len;
+    TelemetryRecord r{};
+    r.seq = static_cast<uint16_t>(p[1] | (p[2] << 8));
+    const uint32_t base_ms = (uint32_t)p[3] | ((uint32_t)p[4] << 8) | ((uint32_t)p[5] << 16) | ((uint32_t)p[6] << 24);
+    p += HEADER_SIZE;
+
+    if (_has_seq) {
+        _lost += static_cast<uint16_t>(r.seq - _seq - 1);
+    }
+    _seq     = r.seq;
+    _has_seq = true;
+    ++_frames;
+
+    while (p < end) {
+        if (end - p < 4) {
+            return false;
+        }
+        uint32_t dt{}, zv{};
+        r.kind    = static_cast<Kind>(*p >> 4);
+        r.channel = *p++ & 0x0F;
+        r.source  = *p++;
+        if (!read_varint(dt, p, end) || !read_varint(zv, p, end)) {
+            return false;
+        }
+        r.ms    = base_ms + dt;
+        r.value = unzigzag(zv);
+        ++_records;
+        if (_callback) {
+            _callback(r);
+        }
+    }
+    return true;
+}
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
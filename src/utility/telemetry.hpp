@@ -0,0 +1,242 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file telemetry.hpp
+  @brief COBS framed binary telemetry for ADC samples and DAC setpoints
+  @details Host buildable, no dependency on M5UnitUnified
+
+  Frame (Multi-byte fixed values are little endian)
+  @verbatim
+  Frame   := COBS(Packet) 0x00
+  Packet  := version(u8) seq(u16) base_ms(u32) Record* crc16(u16)
+  Record  := tag(u8: kind << 4 | channel) source(u8) varint(ms - base_ms) zigzag_varint(value)
+  @endverbatim
+  crc16 is CRC-16/CCITT-FALSE of the packet without crc16.
+  Lost frames are detected by the gap of seq
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_TELEMETRY_HPP
+#define M5_UNIT_ANADIG_UTILITY_TELEMETRY_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+/*!
+  @namespace telemetry
+  @brief Constants and primitives of the telemetry frame
+ */
+namespace telemetry {
+constexpr uint8_t VERSION{0x01};   //!< Packet version
+constexpr size_t HEADER_SIZE{7};   //!< version + seq + base_ms
+constexpr size_t CRC_SIZE{2};      //!< crc16
+constexpr size_t MAX_PACKET{250};  //!< Maximum packet size (COBS in a single block)
+constexpr size_t MAX_RECORD{12};   //!< Maximum encoded record size
+
+/*!
+  @enum Kind
+  @brief Kind of the record
+ */
+enum class Kind : uint8_t {
+    AdcRaw = 1,       //!< ADC raw value
+    AdcMicroVoltage,  //!< ADC voltage(uV)
+    DacCode,          //!< DAC code
+    DacMicroVoltage,  //!< DAC voltage(uV)
+    User,             //!< User defined value
+};
+
+//! @brief Maximum size of COBS encoded data
+constexpr size_t cobs_max_size(const size_t len)
+{
+    return len + len / 254 + 1;
+}
+//! @brief Maximum frame size including the delimiter
+constexpr size_t MAX_FRAME{cobs_max_size(MAX_PACKET) + 1};
+/*!
+  @brief COBS encode
+  @param[out] dst Output buffer (At least cobs_max_size(len) bytes)
+  @return Encoded size (Not including the delimiter)
+ */
+size_t cobs_encode(uint8_t* dst, const uint8_t* src, const size_t len);
+/*!
+  @brief COBS decode
+  @param[out] dst Output buffer (At least len bytes)
+  @param src Encoded data (Not including the delimiter)
+  @return Decoded size, 0 if broken
+ */
+size_t cobs_decode(uint8_t* dst, const uint8_t* src, const size_t len);
+//! @brief CRC-16/CCITT-FALSE
+uint16_t crc16(const uint8_t* p, const size_t len, uint16_t crc = 0xFFFF);
+}  // namespace telemetry
+
+/*!
+  @struct TelemetryRecord
+  @brief Decoded record
+ */
+struct TelemetryRecord {
+    telemetry::Kind kind{};  //!< Kind
+    uint8_t source{};        //!< Source identifier (e.g. unit index)
+    uint8_t channel{};       //!< Channel (0-15)
+    uint32_t ms{};           //!< Timestamp(ms)
+    int32_t value{};         //!< Value
+    uint16_t seq{};          //!< Sequence number of the frame
+};
+
+/*!
+  @class TelemetryWriter
+  @brief Batches records into frames
+  @details Each frame is written by a single sink call.
+  A frame is written when the next record does not fit, the latency is exceeded or flush() is called
+ */
+class TelemetryWriter {
+public:
+    /*!
+      @brief Sink of frames
+      @return Number of bytes written
+      @note For example, Arduino Stream::write or fwrite
+     */
+    using sink_t = std::function<size_t(const uint8_t* buf, const size_t len)>;
+
+    /*!
+      @param sink Sink of frames
+      @param max_latency_ms Flush if the oldest record in the batch is older than this (0: Disabled)
+     */
+    explicit TelemetryWriter(sink_t sink, const uint32_t max_latency_ms = 0)
+        : _sink(sink), _max_latency{max_latency_ms}
+    {
+    }
+
+    /*!
+      @brief Push the record
+      @param kind Kind
+      @param source Source identifier
+      @param channel Channel (0-15)
+      @param value Value
+      @param ms Timestamp(ms)
+      @return True if successful
+     */
+    bool push(const telemetry::Kind kind, const uint8_t source, const uint8_t channel, const int32_t value,
+              const uint32_t ms);
+    //! @brief Push the ADC raw value
+    inline bool pushAdc(const uint8_t source, const int16_t raw, const uint32_t ms, const uint8_t channel = 0)
+    {
+        return push(telemetry::Kind::AdcRaw, source, channel, raw, ms);
+    }
+    //! @brief Push the DAC code
+    inline bool pushDac(const uint8_t source, const uint16_t code, const uint32_t ms, const uint8_t channel = 0)
+    {
+        return push(telemetry::Kind::DacCode, source, channel, code, ms);
+    }
+    /*!
+      @brief Flush if the latency is exceeded
+      @param now_ms Current time(ms)
+     */
+    bool update(const uint32_t now_ms);
+    //! @brief Write the batch as a frame
+    bool flush();
+
+    ///@name Statistics
+    ///@{
+    //! @brief Number of written frames
+    inline uint32_t frames() const
+    {
+        return _frames;
+    }
+    //! @brief Number of written records
+    inline uint32_t records() const
+    {
+        return _records;
+    }
+    //! @brief Number of bytes written to the sink
+    inline uint32_t bytes() const
+    {
+        return _bytes;
+    }
+    //! @brief Number of frames failed to write
+    inline uint32_t failed() const
+    {
+        return _failed;
+    }
+    ///@}
+
+private:
+    sink_t _sink{};
+    uint32_t _max_latency{};
+    uint8_t _packet[telemetry::MAX_PACKET]{};
+    uint8_t _frame[telemetry::MAX_FRAME]{};
+    size_t _len{};
+    uint16_t _count{}, _seq{};
+    uint32_t _base_ms{};
+    uint32_t _frames{}, _records{}, _bytes{}, _failed{};
+};
+
+/*!
+  @class TelemetryReader
+  @brief Incremental decoder of frames
+  @details Input can be split at any position. Broken frames are skipped until the next delimiter
+ */
+class TelemetryReader {
+public:
+    //! @brief Callback for each decoded record
+    using callback_t = std::function<void(const TelemetryRecord& r)>;
+
+    explicit TelemetryReader(callback_t cb) : _callback(cb)
+    {
+    }
+
+    //! @brief Feed the bytes
+    void feed(const uint8_t* buf, const size_t len);
+    //! @brief Reset the state and statistics
+    void reset();
+
+    ///@name Statistics
+    ///@{
+    //! @brief Number of valid frames
+    inline uint32_t frames() const
+    {
+        return _frames;
+    }
+    //! @brief Number of decoded records
+    inline uint32_t records() const
+    {
+        return _records;
+    }
+    //! @brief Number of frames with bad CRC
+    inline uint32_t crcErrors() const
+    {
+        return _crc_errors;
+    }
+    //! @brief Number of broken frames (COBS, size, version or record)
+    inline uint32_t frameErrors() const
+    {
+        return _frame_errors;
+    }
+    //! @brief Number of lost frames estimated by the gap of seq
+    inline uint32_t lost() const
+    {
+        return _lost;
+    }
+    ///@}
+
+private:
+    void parse_frame();
+    bool parse_packet(const uint8_t* p, const size_t len);
+
+    callback_t _callback{};
+    uint8_t _frame[telemetry::MAX_FRAME]{};
+    size_t _len{};
+    bool _overflow{}, _has_seq{};
+    uint16_t _seq{};
+    uint32_t _frames{}, _records{}, _crc_errors{}, _frame_errors{}, _lost{};
+};
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -0,0 +1,202 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file transfer.cpp
+  @brief Sensor transfer-function table indexed by the raw ADC code
+*/
+#include "transfer.hpp"
+#include <cmath>
+#include <limits>
+#include <cstdlib>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+constexpr size_t TransferTable::MAX_ENTRIES;
+
+bool TransferTable::build(const int16_t min_code, const int16_t max_code, const uint16_t segments, function_t f,
+                          const bool interpolate)
+{
+    clear();
+    if (min_code >= max_code || !segments || !f) {
+        return false;
+    }
+    const int32_t span = static_cast<int32_t>(max_code) - min_code;
+    uint8_t shift{};
+    while (((span + (1 << shift) - 1) >> shift) > segments) {
+        ++shift;
+    }
+    // Entries at min + i * step, the last one at or beyond max
+    const size_t size = ((span + (1 << shift) - 1) >> shift) + 1;
+    if (size > MAX_ENTRIES) {
+        return false;
+    }
+    _table.reset(new float[size]);
+    if (!_table) {
+        return false;
+    }
+    for (size_t i = 0; i < size - 1; ++i) {
+        _table[i] = f(static_cast<int16_t>(min_code + static_cast<int32_t>(i << shift)));
+    }
+    const int32_t prev = static_cast<int32_t>((size - 2) << shift);
+    const float last   = f(max_code);
+
+    // Segments between a finite and a NaN value (The last one ends at max_code)
+    auto value_at = [&](const size_t i) { return (i == size - 1) ? last : _table[i]; };
+    auto x_at     = [&](const size_t i) { return (i == size - 1) ? span : static_cast<int32_t>(i << shift); };
+    size_t count{};
+    for (size_t i = 0; i < size - 1; ++i) {
+        count += (std::isnan(value_at(i)) != std::isnan(value_at(i + 1))) ? 1 : 0;
+    }
+    if (count) {
+        _edges.reset(new Edge[count]);
+        if (!_edges) {
+            return false;
+        }
+        for (size_t i = 0; i < size - 1; ++i) {
+            const bool low_valid = !std::isnan(value_at(i));
+            if (low_valid != std::isnan(value_at(i + 1))) {
+                continue;
+            }
+            // Bisect to the last valid code from the finite side
+            int32_t valid = low_valid ? x_at(i) : x_at(i + 1);
+            int32_t fault = low_valid ? x_at(i + 1) : x_at(i);
+            float v       = value_at(low_valid ? i : i + 1);
+            while (std::abs(valid - fault) > 1) {
+                const int32_t mid = (valid + fault) / 2;
+                const float fv    = f(static_cast<int16_t>(min_code + mid));
+                if (std::isnan(fv)) {
+                    fault = mid;
+                } else {
+                    valid = mid;
+                    v     = fv;
+                }
+            }
+            _edges[_edge_count].segment = i;
+            _edges[_edge_count].x       = valid;
+            _edges[_edge_count].value   = v;
+            ++_edge_count;
+        }
+    }
+
+    // The last entry may be beyond max_code (and int16_t), so extrapolated to pass through f(max_code)
+    float from_v   = _table[size - 2];
+    int32_t from_x = prev;
+    const Edge* e  = edge_of(size - 2);
+    if (e && std::isnan(from_v)) {
+        from_v = e->value;
+        from_x = e->x;
+    }
+    _table[size - 1] = (span - prev == (1 << shift) || std::isnan(last) || span == from_x)
+                           ? last
+                           : from_v + (last - from_v) * static_cast<float>((1 << shift) + prev - from_x) /
+                                          static_cast<float>(span - from_x);
+
+    _size        = size;
+    _min         = min_code;
+    _span        = span;
+    _shift       = shift;
+    _inv_step    = 1.0f / (1U << shift);
+    _interpolate = interpolate;
+    return true;
+}
+
+void TransferTable::clear()
+{
+    _table.reset();
+    _edges.reset();
+    _edge_count = 0;
+    _size       = 0;
+}
+
+const TransferTable::Edge* TransferTable::edge_of(const size_t segment) const
+{
+    for (size_t i = 0; i < _edge_count; ++i) {
+        if (_edges[i].segment == segment) {
+            return &_edges[i];
+        }
+    }
+    return nullptr;
+}
+
+float TransferTable::convert(const int16_t code) const
+{
+    if (!_size) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    int32_t x = static_cast<int32_t>(code) - _min;
+    x         = (x < 0) ? 0 : (x > _span) ? _span : x;
+
+    const size_t idx   = static_cast<size_t>(x) >> _shift;
+    const int32_t frac = x & ((1 << _shift) - 1);
+    if (!frac) {
+        return _table[idx];
+    }
+    const float lo = _table[idx];
+    const float hi = _table[idx + 1];
+    if (std::isnan(lo) != std::isnan(hi)) {
+        return convert_edge(idx, x);
+    }
+    if (!_interpolate) {
+        return _table[idx + ((frac << 1) >= (1 << _shift) ? 1 : 0)];
+    }
+    return lo + (hi - lo) * (frac * _inv_step);
+}
+
+// Between a finite and a NaN entry, valid up to the edge code from the finite side
+float TransferTable::convert_edge(const size_t idx, const int32_t x) const
+{
+    const Edge* e = edge_of(idx);
+    if (!e) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    const bool low_valid = !std::isnan(_table[idx]);
+    if (low_valid ? (x > e->x) : (x < e->x)) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    const int32_t xf = static_cast<int32_t>((low_valid ? idx : idx + 1) << _shift);  // Finite entry
+    const float vf   = _table[low_valid ? idx : idx + 1];
+    if (!_interpolate) {
+        return (std::abs(x - xf) <= std::abs(x - e->x)) ? vf : e->value;
+    }
+    return vf + (e->value - vf) * static_cast<float>(x - xf) / static_cast<float>(e->x - xf);
+}
+
+std::function<float(const float mv)> ntc_beta(const float vref_mv, const float r_series, const float r0,
+                                              const float t0, const float beta)
+{
+    const float inv_t0 = 1.0f / (t0 + 273.15f);
+    return [=](const float mv) {
+        if (mv <= 0.0f || mv >= vref_mv) {
+            return std::numeric_limits<float>::quiet_NaN();
+        }
+        const float r = r_series * mv / (vref_mv - mv);
+        return 1.0f / (inv_t0 + std::log(r / r0) / beta) - 273.15f;
+    };
+}
+
+std::function<float(const float mv)> current_loop(const float shunt, const float lower, const float upper)
+{
+    return [=](const float mv) {
+        const float ma = mv / shunt;
+        if (ma < 3.6f || ma > 21.0f) {
+            return std::numeric_limits<float>::quiet_NaN();
+        }
+        return lower + (ma - 4.0f) * (upper - lower) / 16.0f;
+    };
+}
+
+std::function<float(const float mv)> bridge(const float excitation_mv, const float sensitivity,
+                                            const float full_scale, const float zero_mv)
+{
+    const float k = full_scale / (excitation_mv * sensitivity * 0.001f);
+    return [=](const float mv) { return (mv - zero_mv) * k; };
+}
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
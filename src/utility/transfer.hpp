@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file transfer.hpp
+  @brief Sensor transfer-function table indexed by the raw ADC code
+  @details Host buildable, no dependency on M5UnitUnified
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_TRANSFER_HPP
+#define M5_UNIT_ANADIG_UTILITY_TRANSFER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+/*!
+  @class TransferTable
+  @brief Piecewise-linear table from the raw code to the engineering value
+  @details The table has entries at every 2^n codes from the minimum code,
+  so the conversion is a shift, a mask and an optional interpolation (O(1)).
+  Codes out of the range are clamped.
+  If f returns NaN for some codes (Out of the sensor range), the edge of the valid codes within a segment
+  is searched at build time, so the codes valid for f are not interpolated with NaN entries
+  @code
+  TransferTable table;
+  // 10k NTC (B=3950) at the low side of a 10k divider from 3.3V
+  unit.buildTransfer(table, ntc_beta(3300.f, 10000.f, 10000.f, 25.f, 3950.f));
+  unit.setTransfer(&table);
+  // For each sample
+  float celsius = unit.value();
+  @endcode
+ */
+class TransferTable {
+public:
+    static constexpr size_t MAX_ENTRIES{1025};  //!< Maximum number of entries
+
+    //! @brief Engineering value of the code
+    using function_t = std::function<float(const int16_t code)>;
+
+    TransferTable() = default;
+
+    /*!
+      @brief Build the table
+      @param min_code Minimum code
+      @param max_code Maximum code
+      @param segments Number of segments (Rounded up to a power of 2 code step)
+      @param f Transfer function
+      @param interpolate Interpolate between entries if true, nearest entry if false
+      @return True if successful
+      @note f is called for the entries, and for the codes around the edges where f turns NaN
+     */
+    bool build(const int16_t min_code, const int16_t max_code, const uint16_t segments, function_t f,
+               const bool interpolate = true);
+    //! @brief Release the table
+    void clear();
+
+    //! @brief Is built?
+    inline bool valid() const
+    {
+        return _size != 0;
+    }
+    //! @brief Number of entries
+    inline size_t size() const
+    {
+        return _size;
+    }
+    //! @brief Code step between entries
+    inline uint32_t step() const
+    {
+        return 1U << _shift;
+    }
+
+    /*!
+      @brief Convert the code to the engineering value
+      @param code Raw code
+      @return Value, NaN if not built
+     */
+    float convert(const int16_t code) const;
+
+private:
+    // Last valid code in a segment between a finite and a NaN entry
+    struct Edge {
+        size_t segment{};
+        int32_t x{};  // Offset from the minimum code
+        float value{};
+    };
+    const Edge* edge_of(const size_t segment) const;
+    float convert_edge(const size_t idx, const int32_t x) const;
+
+    std::unique_ptr<float[]> _table{};
+    std::unique_ptr<Edge[]> _edges{};
+    size_t _edge_count{};
+    size_t _size{};
+    int32_t _min{}, _span{};
+    uint8_t _shift{};
+    float _inv_step{};
+    bool _interpolate{};
+};
+
+///@name Stock transfer functions of voltage(mV)
+///@{
+/*!
+  @brief NTC thermistor (Beta model) at the low side of a divider
+  @param vref_mv Voltage(mV) across the divider
+  @param r_series Resistance(ohm) of the high side
+  @param r0 Resistance(ohm) of the NTC at t0
+  @param t0 Reference temperature(Celsius)
+  @param beta B constant(K)
+  @return Function to the temperature(Celsius), NaN if open or shorted
+ */
+std::function<float(const float mv)> ntc_beta(const float vref_mv, const float r_series, const float r0,
+                                              const float t0, const float beta);
+/*!
+  @brief 4-20 mA current loop through a shunt resistor
+  @param shunt Resistance(ohm) of the shunt
+  @param lower Value at 4 mA
+  @param upper Value at 20 mA
+  @return Function to the value, NaN if the current is out of 3.6 - 21 mA (NAMUR NE43 fault)
+ */
+std::function<float(const float mv)> current_loop(const float shunt, const float lower, const float upper);
+/*!
+  @brief Ratiometric bridge (Load cell, pressure sensor, etc.)
+  @param excitation_mv Excitation voltage(mV)
+  @param sensitivity Full scale output(mV/V)
+  @param full_scale Value at the full scale output
+  @param zero_mv Output(mV) at zero
+  @return Function to the value
+ */
+std::function<float(const float mv)> bridge(const float excitation_mv, const float sensitivity,
+                                            const float full_scale, const float zero_mv = 0.0f);
+///@}
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
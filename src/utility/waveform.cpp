@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file waveform.cpp
+  @brief Precomputed lookup table waveform generator (DDS)
+*/
+#include "waveform.hpp"
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr float TWO_PI{6.28318530717958647692f};
+
+float sine_shape(const float phase)
+{
+    return std::sin(TWO_PI * phase);
+}
+
+float sawtooth_shape(const float phase)
+{
+    return phase * 2.0f - 1.0f;
+}
+
+float triangle_shape(const float phase)
+{
+    return (phase < 0.25f) ? phase * 4.0f : (phase < 0.75f) ? 2.0f - phase * 4.0f : phase * 4.0f - 4.0f;
+}
+
+float square_shape(const float phase)
+{
+    return (phase < 0.5f) ? 1.0f : -1.0f;
+}
+
+using shape_ptr_t = float (*)(const float);
+constexpr shape_ptr_t shape_table[] = {sine_shape, sawtooth_shape, triangle_shape, square_shape};
+
+}  // namespace
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+constexpr uint8_t WaveformGenerator::MIN_BITS;
+constexpr uint8_t WaveformGenerator::MAX_BITS;
+
+bool WaveformGenerator::build(const Waveform wf, const uint8_t bits, const CodeScale& scale,
+                              const int32_t amplitude_uv, const int32_t offset_uv)
+{
+    return build(wf, bits, code_function_t([&scale](const int32_t uv) { return scale.to_code(uv); }), amplitude_uv,
+                 offset_uv);
+}
+
+bool WaveformGenerator::build(const Waveform wf, const uint8_t bits, const code_function_t& to_code,
+                              const int32_t amplitude_uv, const int32_t offset_uv)
+{
+    const auto idx = static_cast<size_t>(wf);
+    return idx < sizeof(shape_table) / sizeof(shape_table[0]) &&
+           build(shape_function_t(shape_table[idx]), bits, to_code, amplitude_uv, offset_uv);
+}
+
+bool WaveformGenerator::build(const shape_function_t& func, const uint8_t bits, const CodeScale& scale,
+                              const int32_t amplitude_uv, const int32_t offset_uv)
+{
+    return build(func, bits, code_function_t([&scale](const int32_t uv) { return scale.to_code(uv); }), amplitude_uv,
+                 offset_uv);
+}
+
+bool WaveformGenerator::build(const shape_function_t& func, const uint8_t bits, const code_function_t& to_code,
+                              const int32_t amplitude_uv, const int32_t offset_uv)
+{
+    if (!func || !to_code || !allocate(bits)) {
+        return false;
+    }
+    const size_t sz = size();
+    for (size_t i = 0; i < sz; ++i) {
+        const float s  = func(static_cast<float>(i) / sz);
+        const float uv = static_cast<float>(offset_uv) + static_cast<float>(amplitude_uv) * s;
+        _table[i]      = to_code(static_cast<int32_t>(std::lround(std::fmin(std::fmax(uv, -1e9f), 1e9f))));
+    }
+    return true;
+}
+
+bool WaveformGenerator::build(const uint16_t* codes, const uint8_t bits)
+{
+    if (!codes || !allocate(bits)) {
+        return false;
+    }
+    std::memcpy(_table.get(), codes, size() * sizeof(uint16_t));
+    return true;
+}
+
+void WaveformGenerator::setFrequency(const float hz, const float update_hz)
+{
+    _tw               = tuning_word(hz, update_hz);
+    _phase_per_us_q16 = (hz > 0.0f) ? static_cast<uint64_t>(std::llround(hz * 281474976710656.0 / 1000000.0)) : 0;
+}
+
+uint32_t WaveformGenerator::tuning_word(const float hz, const float update_hz)
+{
+    if (hz <= 0.0f || update_hz <= 0.0f) {
+        return 0;
+    }
+    const double tw = static_cast<double>(hz) / update_hz * 4294967296.0;
+    return (tw >= 4294967295.0) ? UINT32_MAX : static_cast<uint32_t>(std::llround(tw));
+}
+
+bool WaveformGenerator::allocate(const uint8_t bits)
+{
+    if (bits < MIN_BITS || bits > MAX_BITS) {
+        return false;
+    }
+    if (!_table || bits != _bits) {
+        _table.reset(new uint16_t[1U << bits]);
+        if (!_table) {
+            _bits = 0;
+            return false;
+        }
+        _bits = bits;
+    }
+    _shift = 32 - bits;
+    _phase = 0;
+    return true;
+}
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
@@ -0,0 +1,215 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+  @file waveform.hpp
+  @brief Precomputed lookup table waveform generator (DDS)
+  @details Host buildable, no dependency on M5UnitUnified
+*/
+#ifndef M5_UNIT_ANADIG_UTILITY_WAVEFORM_HPP
+#define M5_UNIT_ANADIG_UTILITY_WAVEFORM_HPP
+
+#include "fixed_point.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace m5 {
+namespace unit {
+namespace anadig {
+
+/*!
+  @enum Waveform
+  @brief Built-in waveform
+  @details The shapes are in [-1, 1] and start at the phase of sine
+ */
+enum class Waveform : uint8_t {
+    Sine,      //!< Sine
+    Sawtooth,  //!< -1 to 1 rising
+    Triangle,  //!< 0, 1, 0, -1, 0
+    Square,    //!< 1 for the first half, -1 for the second half
+};
+
+/*!
+  @class WaveformGenerator
+  @brief DAC codes table with phase accumulator stepping
+  @details The table holds 2^bits DAC codes computed once by build().
+  Each step costs only a table lookup and an addition
+  @code
+  WaveformGenerator gen;
+  gen.build(Waveform::Sine, 8, unit.scale(), 1650 * 1000, 1650 * 1000);  // 0-3.3V
+  gen.setFrequency(10.0f, 1000.0f);                                        // 10Hz updated at 1kHz
+  // With the linearity correction of the unit
+  gen.build(Waveform::Sine, 8, [&unit](const int32_t uv) { return unit.microvoltage_to_raw(uv); }, 1650 * 1000,
+            1650 * 1000);
+  // Every 1ms
+  unit.writeVoltage(gen.next());
+  @endcode
+ */
+class WaveformGenerator {
+public:
+    static constexpr uint8_t MIN_BITS{1};   //!< Minimum table size 2
+    static constexpr uint8_t MAX_BITS{12};  //!< Maximum table size 4096
+
+    /*!
+      @brief Shape function
+      @param phase Phase [0, 1)
+      @return Value [-1, 1]
+     */
+    using shape_function_t = std::function<float(const float phase)>;
+    /*!
+      @brief Voltage(uV) to DAC code
+      @note e.g. microvoltage_to_raw of the unit, which applies the linearity correction of the unit
+     */
+    using code_function_t = std::function<uint16_t(const int32_t uv)>;
+
+    WaveformGenerator() = default;
+
+    ///@name Build the table
+    ///@{
+    /*!
+      @brief Build the table with built-in waveform
+      @param wf Waveform
+      @param bits log2 of the table size (MIN_BITS - MAX_BITS)
+      @param scale Nominal scale of the DAC (channel)
+      @param amplitude_uv Amplitude(uV)
+      @param offset_uv Offset(uV)
+      @return True if successful
+      @note Output voltage is offset_uv + amplitude_uv * shape, clamped by the scale
+      @note The linearity correction of the unit is not applied. Use the overload with code_function_t for it
+     */
+    bool build(const Waveform wf, const uint8_t bits, const CodeScale& scale, const int32_t amplitude_uv,
+               const int32_t offset_uv);
+    /*!
+      @brief Build the table with built-in waveform and the voltage to code function
+      @param wf Waveform
+      @param bits log2 of the table size (MIN_BITS - MAX_BITS)
+      @param to_code Voltage(uV) to DAC code
+      @param amplitude_uv Amplitude(uV)
+      @param offset_uv Offset(uV)
+      @return True if successful
+     */
+    bool build(const Waveform wf, const uint8_t bits, const code_function_t& to_code, const int32_t amplitude_uv,
+               const int32_t offset_uv);
+    /*!
+      @brief Build the table with arbitrary shape function
+      @param func Shape function
+      @param bits log2 of the table size (MIN_BITS - MAX_BITS)
+      @param scale Nominal scale of the DAC (channel)
+      @param amplitude_uv Amplitude(uV)
+      @param offset_uv Offset(uV)
+      @return True if successful
+     */
+    bool build(const shape_function_t& func, const uint8_t bits, const CodeScale& scale, const int32_t amplitude_uv,
+               const int32_t offset_uv);
+    /*!
+      @brief Build the table with arbitrary shape function and the voltage to code function
+      @param func Shape function
+      @param bits log2 of the table size (MIN_BITS - MAX_BITS)
+      @param to_code Voltage(uV) to DAC code
+      @param amplitude_uv Amplitude(uV)
+      @param offset_uv Offset(uV)
+      @return True if successful
+     */
+    bool build(const shape_function_t& func, const uint8_t bits, const code_function_t& to_code,
+               const int32_t amplitude_uv, const int32_t offset_uv);
+    /*!
+      @brief Build the table with DAC codes
+      @param codes DAC codes (2^bits elements)
+      @param bits log2 of the table size (MIN_BITS - MAX_BITS)
+      @return True if successful
+     */
+    bool build(const uint16_t* codes, const uint8_t bits);
+    //! @brief Is the table built?
+    inline bool valid() const
+    {
+        return static_cast<bool>(_table);
+    }
+    //! @brief Gets the table
+    inline const uint16_t* table() const
+    {
+        return _table.get();
+    }
+    //! @brief Gets the number of elements of the table
+    inline size_t size() const
+    {
+        return valid() ? (1U << _bits) : 0;
+    }
+    ///@}
+
+    ///@name Frequency and phase
+    ///@{
+    /*!
+      @brief Set the frequency
+      @param hz Output frequency(Hz)
+      @param update_hz Rate of next() calls(Hz). If zero, only at() is available
+     */
+    void setFrequency(const float hz, const float update_hz);
+    //! @brief Set the phase increment per next() call directly
+    inline void setTuningWord(const uint32_t tw)
+    {
+        _tw = tw;
+    }
+    //! @brief Gets the phase increment per next() call
+    inline uint32_t tuningWord() const
+    {
+        return _tw;
+    }
+    //! @brief Set the phase (0 - 2^32 for one period)
+    inline void setPhase(const uint32_t phase)
+    {
+        _phase = phase;
+    }
+    //! @brief Gets the phase
+    inline uint32_t phase() const
+    {
+        return _phase;
+    }
+    //! @brief Calculate the tuning word
+    static uint32_t tuning_word(const float hz, const float update_hz);
+    ///@}
+
+    ///@name Stepping
+    ///@{
+    //! @brief Gets the code of the current phase and advance the phase
+    inline uint16_t next()
+    {
+        if (!_table) {
+            return 0;
+        }
+        const uint16_t c = _table[_phase >> _shift];
+        _phase += _tw;
+        return c;
+    }
+    //! @brief Gets the code of the current phase
+    inline uint16_t current() const
+    {
+        return _table ? _table[_phase >> _shift] : 0;
+    }
+    /*!
+      @brief Gets the code at the elapsed time from phase 0
+      @param elapsed_us Elapsed time(us), for example from a monotonic clock
+      @note Does not change the phase
+     */
+    inline uint16_t at(const uint32_t elapsed_us) const
+    {
+        return _table ? _table[static_cast<uint32_t>((elapsed_us * _phase_per_us_q16) >> 16) >> _shift] : 0;
+    }
+    ///@}
+
+private:
+    bool allocate(const uint8_t bits);
+
+    std::unique_ptr<uint16_t[]> _table{};
+    uint8_t _bits{}, _shift{};
+    uint32_t _phase{}, _tw{};
+    uint64_t _phase_per_us_q16{};
+};
+
+}  // namespace anadig
+}  // namespace unit
+}  // namespace m5
+#endif
@@ -237,3 +237,223 @@ TEST_P(TestADS1110, Periodic)
         }
     }
 }
+
+TEST_P(TestADS1110, SampleCallback)
+{
+    SCOPED_TRACE(ustr);
+
+    if (unit->inPeriodic()) {
+        EXPECT_TRUE(unit->stopPeriodicMeasurement());
+    }
+
+    uint32_t count{}, prev_us{};
+    int16_t last{};
+    unit->setSampleCallback([&count, &prev_us, &last](UnitADS11XX&, const Data& d, const uint32_t arrived_us) {
+        if (count) {
+            EXPECT_GT(arrived_us, prev_us);
+        }
+        prev_us = arrived_us;
+        last    = d.differentialValue();
+        ++count;
+    });
+
+    EXPECT_TRUE(unit->startPeriodicMeasurement(Sampling::Rate240, PGA::Gain1));
+    auto timeout_at = m5::utility::millis() + 1000;
+    while (count < 16 && m5::utility::millis() <= timeout_at) {
+        unit->update();
+        if (unit->updated()) {
+            EXPECT_EQ(unit->latest().differentialValue(), last);  // Called before stored
+        }
+    }
+    EXPECT_EQ(count, 16U);
+
+    unit->setSampleCallback(nullptr);
+    unit->update(true);
+    EXPECT_EQ(count, 16U);
+    EXPECT_TRUE(unit->stopPeriodicMeasurement());
+}
+
+TEST_P(TestADS1110, Calibration)
+{
+    SCOPED_TRACE(ustr);
+
+    if (unit->inPeriodic()) {
+        EXPECT_TRUE(unit->stopPeriodicMeasurement());
+    }
+
+    m5::unit::anadig::GainOffset go{};
+    go.gain_q16  = 65536 + 655;  // +1%
+    go.offset_uv = -1500;
+    EXPECT_TRUE(unit->setCorrection(PGA::Gain2, go));
+    EXPECT_EQ(unit->correction(PGA::Gain2).gain_q16, go.gain_q16);
+    EXPECT_EQ(unit->correction(PGA::Gain2).offset_uv, go.offset_uv);
+    EXPECT_TRUE(unit->correction(PGA::Gain1).identity());
+
+    for (auto&& p : pga_table) {
+        auto s = m5::utility::formatString("PGA:%u", p);
+        SCOPED_TRACE(s);
+
+        Data d{};
+        EXPECT_TRUE(unit->measureSingleshot(d, Sampling::Rate240, p));
+        Data nominal      = d;
+        nominal.factor    = unit->config().factor;
+        nominal.lsb_q16   = 0;
+        nominal.offset_uv = 0;
+        EXPECT_NEAR(d.differentialMicroVoltage(), unit->correction(p).apply(nominal.differentialMicroVoltage()), 2);
+        EXPECT_NEAR(d.differentialVoltage() * 1000.f, d.differentialMicroVoltage(), 2.f);
+    }
+
+    // Round trip through the serialized record
+    uint8_t buf[m5::unit::anadig::AdcCalibration::SERIALIZED_SIZE]{};
+    EXPECT_EQ(unit->calibration().serialize(buf, sizeof(buf)), sizeof(buf));
+    EXPECT_TRUE(unit->setCalibration(m5::unit::anadig::AdcCalibration{}));
+    EXPECT_TRUE(unit->calibration().identity());
+
+    m5::unit::anadig::AdcCalibration cal{};
+    EXPECT_TRUE(cal.deserialize(buf, sizeof(buf)));
+    EXPECT_TRUE(unit->setCalibration(cal));
+    EXPECT_EQ(unit->correction(PGA::Gain2).gain_q16, go.gain_q16);
+    EXPECT_EQ(unit->correction(PGA::Gain2).offset_uv, go.offset_uv);
+
+    // Gain must be positive
+    m5::unit::anadig::GainOffset zero{};
+    zero.gain_q16 = 0;
+    EXPECT_FALSE(unit->setCorrection(PGA::Gain1, zero));
+    cal.pga[3].gain_q16 = -65536;
+    EXPECT_FALSE(unit->setCalibration(cal));
+    EXPECT_TRUE(unit->correction(PGA::Gain1).identity());
+    EXPECT_EQ(unit->correction(PGA::Gain2).gain_q16, go.gain_q16);
+
+    EXPECT_TRUE(unit->setCalibration(m5::unit::anadig::AdcCalibration{}));
+}
+
+TEST_P(TestADS1110, Transfer)
+{
+    SCOPED_TRACE(ustr);
+
+    if (unit->inPeriodic()) {
+        EXPECT_TRUE(unit->stopPeriodicMeasurement());
+    }
+    EXPECT_TRUE(unit->startPeriodicMeasurement(Sampling::Rate15, PGA::Gain1));
+
+    // Identity is exact with interpolation
+    m5::unit::anadig::TransferTable table{};
+    EXPECT_TRUE(unit->buildTransfer(table, [](const float mv) { return mv; }));
+    EXPECT_EQ(table.size(), 257U);
+    EXPECT_FALSE(std::isfinite(unit->value()));
+    unit->setTransfer(&table);
+    EXPECT_EQ(unit->transfer(), &table);
+
+    uint32_t cnt{4};
+    auto timeout_at = m5::utility::millis() + 2000;
+    while (cnt && m5::utility::millis() <= timeout_at) {
+        unit->update();
+        if (unit->updated()) {
+            EXPECT_NEAR(unit->latest().value(), unit->latest().differentialVoltage(), 1e-2f);
+            --cnt;
+        }
+    }
+    EXPECT_EQ(cnt, 0U);
+
+    unit->setTransfer(nullptr);
+    unit->flush();
+    EXPECT_TRUE(unit->stopPeriodicMeasurement());
+}
+
+TEST_P(TestADS1110, HumRejection)
+{
+    SCOPED_TRACE(ustr);
+
+    if (unit->inPeriodic()) {
+        EXPECT_TRUE(unit->stopPeriodicMeasurement());
+    }
+
+    m5::unit::anadig::HumConfig cfg{};
+    cfg.enable = true;
+    cfg.freq   = 60.f;
+    EXPECT_TRUE(unit->startPeriodicMeasurement(Sampling::Rate15, PGA::Gain1));
+    EXPECT_FALSE(unit->setHumRejection(cfg));  // Aliased to DC
+    EXPECT_FALSE(unit->humRejector().enabled());
+    EXPECT_TRUE(unit->stopPeriodicMeasurement());
+
+    EXPECT_TRUE(unit->startPeriodicMeasurement(Sampling::Rate240, PGA::Gain1));
+    for (auto&& f : {m5::unit::anadig::HumFilter::Notch, m5::unit::anadig::HumFilter::Average}) {
+        cfg.filter = f;
+        EXPECT_TRUE(unit->setHumRejection(cfg));
+        EXPECT_TRUE(unit->humRejector().enabled());
+        EXPECT_EQ(unit->humRejector().detector().block(), 256U);  // 64 periods
+
+        auto timeout_at = m5::utility::millis() + 3000;
+        while (unit->humRejector().detector().blocks() < 2 && m5::utility::millis() <= timeout_at) {
+            unit->update();
+        }
+        EXPECT_GE(unit->humRejector().detector().blocks(), 2U);
+        EXPECT_GE(unit->humMicroVoltage(), 0);
+    }
+
+    // Set up again with the new sampling rate
+    EXPECT_TRUE(unit->stopPeriodicMeasurement());
+    EXPECT_TRUE(unit->startPeriodicMeasurement(Sampling::Rate30, PGA::Gain1));
+    EXPECT_FALSE(unit->humRejector().enabled());
+
+    cfg.enable = false;
+    EXPECT_TRUE(unit->setHumRejection(cfg));
+    EXPECT_TRUE(unit->stopPeriodicMeasurement());
+}
+
+TEST_P(TestADS1110, Spectrum)
+{
+    SCOPED_TRACE(ustr);
+
+    if (unit->inPeriodic()) {
+        EXPECT_TRUE(unit->stopPeriodicMeasurement());
+    }
+    EXPECT_TRUE(unit->startPeriodicMeasurement(Sampling::Rate240, PGA::Gain1));
+
+    auto timeout_at = m5::utility::millis() + 1000;
+    while (!unit->full() && m5::utility::millis() <= timeout_at) {
+        unit->update();
+    }
+    EXPECT_TRUE(unit->full());
+
+    m5::unit::anadig::Spectrum spectrum{};
+    EXPECT_TRUE(spectrum.begin(STORED_SIZE * 2));
+    EXPECT_FALSE(unit->analyzeStored(spectrum));   // Not enough samples
+    EXPECT_FALSE(unit->analyzeCapture(spectrum));  // Not captured
+
+    EXPECT_TRUE(spectrum.begin(STORED_SIZE));
+    m5::unit::anadig::DeadbandConfig dcfg{};
+    dcfg.enable = true;
+    unit->setDeadband(dcfg);
+    EXPECT_FALSE(unit->analyzeStored(spectrum));  // Not uniform
+    unit->setDeadband(m5::unit::anadig::DeadbandConfig{});
+
+    EXPECT_TRUE(unit->analyzeStored(spectrum));
+    EXPECT_FLOAT_EQ(spectrum.frequency(spectrum.bins() - 1), 120.f);
+    EXPECT_GE(spectrum.result().dominant_hz, 0.f);
+    EXPECT_LE(spectrum.result().dominant_hz, 120.f);
+
+    unit->flush();
+    EXPECT_TRUE(unit->stopPeriodicMeasurement());
+}
+
+TEST(ADS1110Fixed, Constexpr)
+{
+    using Fixed = UnitADS1110Fixed<Sampling::Rate60, PGA::Gain2>;
+    static_assert(Fixed::CONFIG_VALUE == 0x05, "Invalid config value");
+    static_assert(Fixed::INTERVAL == ads1110::interval(Sampling::Rate60), "Invalid interval");
+
+    for (auto&& r : rate_table) {
+        EXPECT_GE(ads1110::interval(r), interval_table[m5::stl::to_underlying(r)]);
+    }
+
+    Data d{};
+    d.rate   = m5::stl::to_underlying(Sampling::Rate60);
+    d.pga    = PGA::Gain2;
+    d.factor = 100.f / 610.f;
+    for (int32_t v = -32768; v <= 32767; v += 257) {
+        d.raw[0] = (v >> 8) & 0xFF;
+        d.raw[1] = v & 0xFF;
+        EXPECT_NEAR(Fixed::raw_to_voltage(d.differentialValue()), d.differentialVoltage(), 1e-2f) << v;
+    }
+}
@@ -13,6 +13,8 @@
 #include <googletest/test_template.hpp>
 #include <googletest/test_helper.hpp>
 #include <unit/unit_GP8413.hpp>
+#include <unit/unit_MCP4725.hpp>
+#include <unit/dac_group.hpp>
 #include <cmath>
 #include <random>
 
@@ -89,3 +91,236 @@ TEST_P(TestGP8413, Store)
     auto duration = m5::utility::millis() - start_at;
     EXPECT_GE(duration, 7);  // Need wait at least 7ms for store
 }
+
+TEST_P(TestGP8413, StoreAsync)
+{
+    SCOPED_TRACE(ustr);
+
+    uint32_t called{};
+    unit->setStoreCallback([&called](UnitGP8413&) { ++called; });
+
+    EXPECT_TRUE(unit->writeBothVoltage((uint16_t)0x1234, (uint16_t)0x2345));
+    auto start_at = m5::utility::millis();
+    EXPECT_TRUE(unit->storeBothVoltageAsync());
+    EXPECT_LT(m5::utility::millis() - start_at, 7);  // Not blocked
+    EXPECT_TRUE(unit->storeBusy());
+
+    // Conflicting writes are refused or deferred
+    EXPECT_FALSE(unit->storeBothVoltageAsync());
+    EXPECT_FALSE(unit->storeBothVoltage());
+    EXPECT_FALSE(unit->writeOutputRange(Output::Range10V, Output::Range10V));
+    EXPECT_TRUE(unit->writeVoltage(Channel::One, (uint16_t)0x3456));
+    EXPECT_EQ(unit->lastValue(Channel::One), 0x2345);
+
+    while (unit->storeBusy() && m5::utility::millis() - start_at < 100) {
+        unit->update();
+        m5::utility::delay(1);
+    }
+    auto duration = m5::utility::millis() - start_at;
+    EXPECT_GE(duration, 7);  // Need wait at least 7ms for store
+    EXPECT_EQ(unit->storeState(), StoreState::Idle);
+    EXPECT_EQ(called, 1U);
+    EXPECT_EQ(unit->lastValue(Channel::Zero), 0x1234);
+    EXPECT_EQ(unit->lastValue(Channel::One), 0x3456);  // Deferred value applied
+
+    // Skip if unchanged
+    EXPECT_TRUE(unit->writeVoltage(Channel::One, (uint16_t)0x2345));
+    EXPECT_TRUE(unit->storeBothVoltageAsync());
+    EXPECT_FALSE(unit->storeBusy());
+    EXPECT_EQ(unit->storeSkipped(), 1U);
+    EXPECT_TRUE(unit->storeBothVoltageAsync(true));  // Forced
+    EXPECT_TRUE(unit->storeBusy());
+    while (unit->storeBusy()) {
+        unit->update();
+        m5::utility::delay(1);
+    }
+    EXPECT_EQ(called, 2U);
+    unit->setStoreCallback(nullptr);
+}
+
+TEST_P(TestGP8413, Ramp)
+{
+    SCOPED_TRACE(ustr);
+
+    EXPECT_TRUE(unit->writeBothVoltage((uint16_t)0, (uint16_t)0));
+    EXPECT_FALSE(unit->rampMicroVoltage(Channel::Zero, -1, 1000));
+
+    // Both channels at the different rates
+    EXPECT_TRUE(unit->rampVoltage(Channel::Zero, 1000.0f, 10000));       // 100ms
+    EXPECT_TRUE(unit->rampVoltage(Channel::One, 1000.0f, 10000, true));  // 150ms
+    EXPECT_TRUE(unit->ramping(Channel::Zero));
+    EXPECT_TRUE(unit->ramping(Channel::One));
+
+    uint16_t prev[2]{};
+    auto start_at = m5::utility::millis();
+    while ((unit->ramping(Channel::Zero) || unit->ramping(Channel::One)) && m5::utility::millis() - start_at < 500) {
+        unit->update();
+        EXPECT_GE(unit->lastValue(Channel::Zero), prev[0]);
+        EXPECT_GE(unit->lastValue(Channel::One), prev[1]);
+        prev[0] = unit->lastValue(Channel::Zero);
+        prev[1] = unit->lastValue(Channel::One);
+    }
+    auto elapsed = m5::utility::millis() - start_at;
+    M5_LOGI("Elapsed:%u", (uint32_t)elapsed);
+    EXPECT_GE(elapsed, 149U);
+    EXPECT_EQ(unit->lastValue(Channel::Zero), unit->microvoltage_to_raw(Channel::Zero, 1000 * 1000));
+    EXPECT_EQ(unit->lastValue(Channel::One), unit->microvoltage_to_raw(Channel::One, 1000 * 1000));
+
+    // Stop
+    EXPECT_TRUE(unit->rampMicroVoltage(Channel::One, 0, 1000));
+    unit->update();
+    unit->stopRamp(Channel::One);
+    EXPECT_FALSE(unit->ramping(Channel::One));
+    auto v = unit->lastValue(Channel::One);
+    unit->update();
+    EXPECT_EQ(unit->lastValue(Channel::One), v);
+
+    EXPECT_TRUE(unit->writeBothVoltage((uint16_t)0, (uint16_t)0));
+}
+
+TEST_P(TestGP8413, Setpoint)
+{
+    SCOPED_TRACE(ustr);
+
+    auto& q = unit->setpointQueue();
+    EXPECT_FALSE(unit->pushSetpoint(0, Channel::Zero, 0));  // Not allocated
+    EXPECT_TRUE(q.begin(32, 500));
+
+    auto t = m5::utility::micros() + 10000;
+    for (uint16_t i = 0; i < 16; ++i) {
+        EXPECT_TRUE(unit->pushSetpoint(t + i * 2000U, Channel::Zero, i * 2048));
+        EXPECT_TRUE(unit->pushSetpoint(t + i * 2000U, Channel::One, 0x7FFF - i * 2048));
+    }
+    EXPECT_TRUE(q.push(t + 32000U, 2, 0));  // Invalid channel
+
+    auto start_at = m5::utility::millis();
+    while (!q.empty() && m5::utility::millis() - start_at < 500) {
+        unit->update();
+    }
+    M5_LOGI("Issued:%u Late:%u Max:%u Mean:%u", q.issued(), q.late(), q.maxLateness(), q.meanLateness());
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.issued() + q.skipped(), 32U);
+    EXPECT_EQ(q.failed(), 1U);
+    EXPECT_EQ(unit->lastValue(Channel::Zero), 15U * 2048U);
+    EXPECT_EQ(unit->lastValue(Channel::One), 0x7FFFU - 15U * 2048U);
+
+    EXPECT_TRUE(unit->writeBothVoltage((uint16_t)0, (uint16_t)0));
+}
+
+TEST_P(TestGP8413, Group)
+{
+    SCOPED_TRACE(ustr);
+
+    DACGroup group;
+    auto c0 = group.add(*unit, Channel::Zero);
+    auto c1 = group.add(*unit, Channel::One);
+    EXPECT_EQ(c0, 0);
+    EXPECT_EQ(c1, 1);
+    EXPECT_LT(group.add(*unit, Channel::One), 0);  // Duplicated
+    EXPECT_EQ(group.members(), 2U);
+    EXPECT_EQ(group.transactions(), 1U);  // Both channels in a single transaction
+
+    EXPECT_FALSE(group.set(2, 0));
+    EXPECT_TRUE(group.set(c0, 0x1234));
+    EXPECT_TRUE(group.setMicroVoltage(c1, 2500 * 1000));
+    EXPECT_TRUE(group.commit());
+    EXPECT_EQ(unit->lastValue(Channel::Zero), 0x1234U);
+    EXPECT_EQ(unit->lastValue(Channel::One), unit->microvoltage_to_raw(Channel::One, 2500 * 1000));
+    EXPECT_EQ(group.skew(), 0U);
+    EXPECT_EQ(group.commits(), 1U);
+    M5_LOGI("Duration:%u", group.duration());
+
+    // Deferred while storing
+    EXPECT_TRUE(unit->storeBothVoltageAsync(true));
+    EXPECT_TRUE(group.set(c0, 0x2345));
+    EXPECT_TRUE(group.commit());
+    EXPECT_EQ(unit->lastValue(Channel::Zero), 0x1234U);
+    while (unit->storeBusy()) {
+        unit->update();
+        m5::utility::delay(1);
+    }
+    EXPECT_EQ(unit->lastValue(Channel::Zero), 0x2345U);
+
+    EXPECT_TRUE(unit->writeBothVoltage((uint16_t)0, (uint16_t)0));
+}
+
+TEST(DACGroup, Capacity)
+{
+    // 8 GP8413 with both channels and MCP4725 (Not connected, members only)
+    UnitGP8413 gp8413[8]{};
+    UnitMCP4725 mcp4725[DACGroup::MAX_TRANSACTIONS - 8 + 1]{};
+
+    DACGroup group;
+    for (auto&& u : gp8413) {
+        EXPECT_GE(group.add(u, Channel::Zero), 0);
+        EXPECT_GE(group.add(u, Channel::One), 0);
+    }
+    EXPECT_EQ(group.members(), 16U);
+    EXPECT_EQ(group.transactions(), 8U);
+
+    for (uint8_t i = 0; i < DACGroup::MAX_TRANSACTIONS - 8; ++i) {
+        EXPECT_GE(group.add(mcp4725[i]), 0) << i;
+    }
+    EXPECT_EQ(group.members(), 24U);
+    EXPECT_EQ(group.transactions(), DACGroup::MAX_TRANSACTIONS);
+    EXPECT_LT(group.add(mcp4725[DACGroup::MAX_TRANSACTIONS - 8]), 0);  // Full
+}
+
+TEST_P(TestGP8413, Convert)
+{
+    SCOPED_TRACE(ustr);
+
+    const float mv[] = {-1.f, 0.f, 1234.5f, 4999.9f, 5000.f, 9999.f, 12000.f};
+    uint16_t raw[m5::stl::size(mv)]{};
+
+    for (auto&& r : {Output::Range5V, Output::Range10V}) {
+        SCOPED_TRACE(m5::stl::to_underlying(r));
+        EXPECT_TRUE(unit->writeOutputRange(r, r));
+        unit->convertToRaw(Channel::Zero, raw, mv, m5::stl::size(mv));
+        const float max_mv = unit->maximumVoltage(Channel::Zero);
+        for (size_t i = 0; i < m5::stl::size(mv); ++i) {
+            const int32_t ref = m5::unit::anadig::dac_voltage_to_code(mv[i], max_mv, max_mv, UnitGP8413::RESOLUTION);
+            EXPECT_LE(std::abs(raw[i] - ref), 1) << mv[i];
+        }
+    }
+    EXPECT_TRUE(unit->writeOutputRange(Output::Range10V, Output::Range10V));
+}
+
+TEST_P(TestGP8413, SwitchRange)
+{
+    SCOPED_TRACE(ustr);
+
+    EXPECT_TRUE(unit->writeOutputRange(Output::Range5V, Output::Range10V));
+    EXPECT_TRUE(unit->writeBothMicroVoltage(2500 * 1000, 4000 * 1000));
+    const int32_t uv0 = unit->raw_to_microvoltage(Channel::Zero, unit->lastValue(Channel::Zero));
+    const int32_t uv1 = unit->raw_to_microvoltage(Channel::One, unit->lastValue(Channel::One));
+
+    // Keep the voltage
+    EXPECT_TRUE(unit->switchOutputRange(Output::Range10V, Output::Range5V));
+    EXPECT_EQ(unit->range(Channel::Zero), Output::Range10V);
+    EXPECT_EQ(unit->range(Channel::One), Output::Range5V);
+    EXPECT_NEAR(unit->raw_to_microvoltage(Channel::Zero, unit->lastValue(Channel::Zero)), uv0, 400);
+    EXPECT_NEAR(unit->raw_to_microvoltage(Channel::One, unit->lastValue(Channel::One)), uv1, 400);
+
+    // Exceeding the new range
+    EXPECT_TRUE(unit->writeOutputRange(Output::Range10V, Output::Range10V));
+    EXPECT_TRUE(unit->writeMicroVoltage(Channel::Zero, 8000 * 1000));
+    EXPECT_FALSE(unit->switchOutputRange(Output::Range5V, Output::Range10V));
+    EXPECT_EQ(unit->range(Channel::Zero), Output::Range10V);
+
+    // Finest range
+    EXPECT_EQ(UnitGP8413::finestRange(0), Output::Range5V);
+    EXPECT_EQ(UnitGP8413::finestRange(5000 * 1000), Output::Range5V);
+    EXPECT_EQ(UnitGP8413::finestRange(5000 * 1000 + 1), Output::Range10V);
+    EXPECT_FALSE(unit->writeMicroVoltageAutoRange(Channel::Zero, -1));
+    EXPECT_TRUE(unit->writeMicroVoltageAutoRange(Channel::Zero, 3000 * 1000));
+    EXPECT_EQ(unit->range(Channel::Zero), Output::Range5V);
+    EXPECT_EQ(unit->range(Channel::One), Output::Range10V);
+    EXPECT_EQ(unit->lastValue(Channel::Zero), unit->microvoltage_to_raw(Channel::Zero, 3000 * 1000));
+    EXPECT_TRUE(unit->writeVoltageAutoRange(Channel::Zero, 7000.0f));
+    EXPECT_EQ(unit->range(Channel::Zero), Output::Range10V);
+    EXPECT_EQ(unit->lastValue(Channel::Zero), unit->microvoltage_to_raw(Channel::Zero, 7000 * 1000));
+
+    EXPECT_TRUE(unit->writeOutputRange(Output::Range10V, Output::Range10V));
+    EXPECT_TRUE(unit->writeBothVoltage((uint16_t)0, (uint16_t)0));
+}
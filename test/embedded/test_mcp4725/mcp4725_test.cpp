@@ -148,3 +148,201 @@ TEST_P(TestMCP4725, Output)
     EXPECT_EQ(unit->powerDown(), PowerDown::Normal);
     EXPECT_TRUE(unit->writeVoltageAndEEPROM(0U));
 }
+
+TEST_P(TestMCP4725, Burst)
+{
+    SCOPED_TRACE(ustr);
+
+    PowerDown pwd{};
+    uint16_t raw{};
+    uint16_t codes[200]{};
+    for (uint16_t i = 0; i < m5::stl::size(codes); ++i) {
+        codes[i] = i * 20;
+    }
+
+    EXPECT_FALSE(unit->writeVoltageBurst(nullptr, 1));
+    EXPECT_FALSE(unit->writeVoltageBurst(codes, 0));
+    EXPECT_FALSE(unit->writeVoltageBurst(codes, 1, 0));
+
+    // Less than, equal to and more than a transaction
+    for (size_t num : {size_t(1), UnitMCP4725::MAX_BURST_FRAMES, m5::stl::size(codes)}) {
+        EXPECT_TRUE(unit->writeVoltageBurst(codes, num));
+        EXPECT_EQ(unit->lastValue(), codes[num - 1]);
+        EXPECT_TRUE(unit->readDACRegister(pwd, raw));
+        EXPECT_EQ(raw, codes[num - 1]);
+    }
+
+    EXPECT_TRUE(unit->writeVoltageBurst(codes, 10, 4));
+    EXPECT_TRUE(unit->readDACRegister(pwd, raw));
+    EXPECT_EQ(raw, codes[9]);
+
+    // 400kHz: 45us per frame
+    EXPECT_EQ(unit->burstRepeat(0), 1U);
+    EXPECT_EQ(unit->burstRepeat(45), 1U);
+    EXPECT_EQ(unit->burstRepeat(450), 10U);
+    EXPECT_EQ(unit->burstRepeat(1000000), 255U);
+
+    EXPECT_TRUE(unit->writeVoltage(0U));
+}
+
+TEST_P(TestMCP4725, EEPROMAsync)
+{
+    SCOPED_TRACE(ustr);
+
+    PowerDown pwd{};
+    uint16_t raw{};
+    uint32_t called{};
+    bool result{};
+    unit->setEEPROMCallback([&called, &result](UnitMCP4725&, const bool success) {
+        ++called;
+        result = success;
+    });
+
+    EXPECT_EQ(unit->eepromState(), EEPROMState::Idle);
+    EXPECT_TRUE(unit->writeVoltageAndEEPROMAsync((uint16_t)1234));
+    EXPECT_TRUE(unit->eepromBusy());
+    EXPECT_EQ(unit->eepromState(), EEPROMState::Writing);
+
+    // Conflicting EEPROM writes are refused
+    EXPECT_FALSE(unit->writeVoltageAndEEPROMAsync((uint16_t)2345));
+    EXPECT_FALSE(unit->writeVoltageAndEEPROM((uint16_t)2345));
+    uint16_t codes[2]{1, 2};
+    EXPECT_FALSE(unit->writeVoltageBurst(codes, 2));
+
+    // Fast mode output is deferred
+    EXPECT_TRUE(unit->writeVoltage((uint16_t)100));
+    EXPECT_TRUE(unit->writeVoltage((uint16_t)200));
+    EXPECT_EQ(unit->lastValue(), 1234U);
+
+    auto timeout_at = m5::utility::millis() + 100;
+    auto start_at   = m5::utility::millis();
+    while (unit->eepromBusy() && m5::utility::millis() <= timeout_at) {
+        unit->update();
+        m5::utility::delay(1);
+    }
+    auto elapsed = m5::utility::millis() - start_at;
+    M5_LOGI("Elapsed:%u", (uint32_t)elapsed);
+
+    EXPECT_EQ(unit->eepromState(), EEPROMState::Idle);
+    EXPECT_EQ(called, 1U);
+    EXPECT_TRUE(result);
+    EXPECT_EQ(unit->lastValue(), 200U);  // Deferred value applied
+    EXPECT_TRUE(unit->readDACRegister(pwd, raw));
+    EXPECT_EQ(raw, 200U);
+    EXPECT_TRUE(unit->readEEPROM(pwd, raw));
+    EXPECT_EQ(raw, 1234U);
+
+    unit->update();
+    EXPECT_EQ(called, 1U);
+
+    unit->setEEPROMCallback(nullptr);
+    EXPECT_TRUE(unit->writeVoltageAndEEPROM((uint16_t)0));
+}
+
+TEST_P(TestMCP4725, Ramp)
+{
+    SCOPED_TRACE(ustr);
+
+    EXPECT_TRUE(unit->writeVoltage((uint16_t)0));
+    EXPECT_FALSE(unit->rampMicroVoltage(-1, 1000));
+
+    for (auto&& s_curve : {false, true}) {
+        SCOPED_TRACE(s_curve);
+        EXPECT_TRUE(unit->writeVoltage((uint16_t)0));
+        EXPECT_TRUE(unit->rampVoltage(1000.0f, 10000, s_curve));  // 100ms (150ms with S-curve)
+        EXPECT_TRUE(unit->ramping());
+
+        uint16_t prev{};
+        uint32_t count{};
+        auto start_at = m5::utility::millis();
+        while (unit->ramping() && m5::utility::millis() - start_at < 500) {
+            unit->update();
+            EXPECT_GE(unit->lastValue(), prev);
+            prev = unit->lastValue();
+            ++count;
+        }
+        auto elapsed = m5::utility::millis() - start_at;
+        M5_LOGI("Elapsed:%u Updates:%u", (uint32_t)elapsed, count);
+        EXPECT_FALSE(unit->ramping());
+        EXPECT_GE(elapsed, s_curve ? 149U : 99U);
+        EXPECT_EQ(unit->lastValue(), unit->microvoltage_to_raw(1000 * 1000));
+    }
+
+    // Stop at the current output
+    EXPECT_TRUE(unit->rampMicroVoltage(0, 1000));
+    unit->update();
+    unit->stopRamp();
+    EXPECT_FALSE(unit->ramping());
+    auto v = unit->lastValue();
+    unit->update();
+    EXPECT_EQ(unit->lastValue(), v);
+
+    EXPECT_TRUE(unit->writeVoltage((uint16_t)0));
+}
+
+TEST_P(TestMCP4725, Setpoint)
+{
+    SCOPED_TRACE(ustr);
+
+    auto& q = unit->setpointQueue();
+    EXPECT_FALSE(unit->pushSetpoint(0, 0));  // Not allocated
+    EXPECT_TRUE(q.begin(16, 500));
+
+    auto t = m5::utility::micros() + 10000;
+    for (uint16_t i = 0; i < 16; ++i) {
+        EXPECT_TRUE(unit->pushSetpoint(t + i * 2000U, i * 256));
+    }
+    EXPECT_FALSE(unit->pushSetpoint(t + 32000U, 0));  // Full
+
+    auto start_at = m5::utility::millis();
+    while (!q.empty() && m5::utility::millis() - start_at < 500) {
+        unit->update();
+    }
+    M5_LOGI("Issued:%u Late:%u Max:%u Mean:%u", q.issued(), q.late(), q.maxLateness(), q.meanLateness());
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.issued() + q.skipped(), 16U);
+    EXPECT_EQ(q.failed(), 0U);
+    EXPECT_EQ(unit->lastValue(), 15U * 256U);
+
+    EXPECT_TRUE(unit->writeVoltage((uint16_t)0));
+}
+
+TEST_P(TestMCP4725, Dither)
+{
+    SCOPED_TRACE(ustr);
+
+    EXPECT_FALSE(unit->ditherMicroVoltage(-1, 1000));
+    EXPECT_FALSE(unit->ditherMicroVoltage(1000, 0));
+
+    // Halfway between codes
+    const int32_t uv = (unit->raw_to_microvoltage(1000) + unit->raw_to_microvoltage(1001)) / 2;
+    EXPECT_TRUE(unit->ditherMicroVoltage(uv, 1000));
+    EXPECT_TRUE(unit->dithering());
+    EXPECT_EQ(unit->ditherRate(), 1000U);
+
+    uint32_t count[2]{};
+    auto start_at = m5::utility::millis();
+    uint16_t prev = unit->lastValue();
+    while (m5::utility::millis() - start_at < 100) {
+        unit->update();
+        auto v = unit->lastValue();
+        EXPECT_TRUE(v == 1000 || v == 1001);
+        if (v != prev) {
+            ++count[v - 1000];
+            prev = v;
+        }
+    }
+    M5_LOGI("Changes:%u/%u", count[0], count[1]);
+    EXPECT_GT(count[0], 20U);
+    EXPECT_GT(count[1], 20U);
+
+    // Bounded rate
+    EXPECT_TRUE(unit->ditherMicroVoltage(uv, 1000000));
+    EXPECT_LT(unit->ditherRate(), 1000000U);
+
+    // Ramp stops dithering
+    EXPECT_TRUE(unit->rampMicroVoltage(0, 0));
+    EXPECT_FALSE(unit->dithering());
+    unit->update();
+    EXPECT_EQ(unit->lastValue(), 0U);
+}
@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for calibration
+*/
+#include <gtest/gtest.h>
+#include <utility/calibration.hpp>
+#include <cmath>
+
+using namespace m5::unit::anadig;
+
+TEST(Calibration, TwoPoint)
+{
+    // ADC reads 0.5% high with +1.2 mV offset
+    auto measure = [](const int32_t uv) { return static_cast<int32_t>(std::lround(uv * 1.005 + 1200.0)); };
+
+    GainOffset go{};
+    EXPECT_TRUE(two_point_correction(measure(100000), 100000, measure(3000000), 3000000, go));
+    EXPECT_NEAR(go.gain_q16, std::lround(65536.0 / 1.005), 1);
+    // Resolution of the gain is 1/65536 (46 uV at 3V)
+    for (int32_t uv = -3000000; uv <= 3000000; uv += 12345) {
+        EXPECT_NEAR(go.apply(measure(uv)), uv, 46) << uv;
+    }
+
+    // Reversed order gives the same result
+    GainOffset rev{};
+    EXPECT_TRUE(two_point_correction(measure(3000000), 3000000, measure(100000), 100000, rev));
+    EXPECT_EQ(rev.gain_q16, go.gain_q16);
+    EXPECT_NEAR(rev.offset_uv, go.offset_uv, 1);
+
+    // Invalid
+    GainOffset prev = go;
+    EXPECT_FALSE(two_point_correction(1000, 1000, 1000, 2000, go));  // Same measurement
+    EXPECT_FALSE(two_point_correction(1000, 2000, 2000, 1000, go));  // Negative gain
+    EXPECT_EQ(go.gain_q16, prev.gain_q16);
+    EXPECT_EQ(go.offset_uv, prev.offset_uv);
+}
+
+TEST(Calibration, Serialize)
+{
+    AdcCalibration cal{};
+    EXPECT_TRUE(cal.identity());
+    EXPECT_TRUE(cal.valid());
+
+    cal.id = 0x12345678;
+    for (uint8_t i = 0; i < AdcCalibration::NUM_PGA; ++i) {
+        cal.pga[i].gain_q16  = 65536 + 100 * (i + 1);
+        cal.pga[i].offset_uv = -1500 + 1000 * i;
+    }
+    EXPECT_FALSE(cal.identity());
+
+    uint8_t buf[AdcCalibration::SERIALIZED_SIZE]{};
+    EXPECT_EQ(cal.serialize(buf, sizeof(buf) - 1), 0U);
+    EXPECT_EQ(cal.serialize(buf, sizeof(buf)), AdcCalibration::SERIALIZED_SIZE);
+    EXPECT_EQ(buf[0], 'A');
+    EXPECT_EQ(buf[1], 'C');
+    EXPECT_EQ(buf[2], AdcCalibration::VERSION);
+
+    AdcCalibration out{};
+    EXPECT_TRUE(out.deserialize(buf, sizeof(buf)));
+    EXPECT_EQ(out.id, cal.id);
+    for (uint8_t i = 0; i < AdcCalibration::NUM_PGA; ++i) {
+        EXPECT_EQ(out.pga[i].gain_q16, cal.pga[i].gain_q16);
+        EXPECT_EQ(out.pga[i].offset_uv, cal.pga[i].offset_uv);
+    }
+
+    // Broken records are rejected and the record is not changed
+    AdcCalibration keep{};
+    EXPECT_FALSE(keep.deserialize(buf, sizeof(buf) - 1));
+    for (size_t i = 0; i < sizeof(buf); ++i) {
+        buf[i] ^= 0x01;
+        EXPECT_FALSE(keep.deserialize(buf, sizeof(buf))) << i;
+        buf[i] ^= 0x01;
+    }
+    EXPECT_TRUE(keep.identity());
+    EXPECT_EQ(keep.id, 0U);
+
+    // Gain must be positive
+    out.pga[2].gain_q16 = 0;
+    EXPECT_FALSE(out.valid());
+    EXPECT_EQ(out.serialize(buf, sizeof(buf)), AdcCalibration::SERIALIZED_SIZE);
+    EXPECT_FALSE(keep.deserialize(buf, sizeof(buf)));
+
+    keep.clear();
+    out.clear();
+    EXPECT_TRUE(out.identity());
+    EXPECT_TRUE(out.valid());
+}
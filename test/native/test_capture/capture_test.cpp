@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for Capture
+*/
+#include <gtest/gtest.h>
+#include <utility/capture.hpp>
+
+using namespace m5::unit::anadig;
+
+TEST(Capture, Config)
+{
+    Capture cap{};
+    CaptureConfig cfg{};
+    cfg.post = 0;
+    EXPECT_FALSE(cap.config(cfg));
+
+    cfg.pre  = 0;
+    cfg.post = 1;
+    EXPECT_TRUE(cap.config(cfg));
+    EXPECT_FALSE(cap.armed());
+    EXPECT_FALSE(cap.push(0));
+}
+
+TEST(Capture, Rising)
+{
+    Capture cap{};
+    CaptureConfig cfg{};
+    cfg.trigger = Trigger::Rising;
+    cfg.level   = 100;
+    cfg.pre     = 4;
+    cfg.post    = 3;
+    EXPECT_TRUE(cap.config(cfg));
+    cap.arm();
+
+    // Ring wraps several times before trigger
+    for (int16_t i = 0; i < 50; ++i) {
+        EXPECT_FALSE(cap.push(i));
+    }
+    EXPECT_FALSE(cap.push(200));  // Trigger
+    EXPECT_TRUE(cap.triggered());
+    EXPECT_FALSE(cap.push(201));
+    EXPECT_TRUE(cap.push(202));
+    EXPECT_FALSE(cap.triggered());
+    EXPECT_TRUE(cap.armed());  // auto rearm
+
+    ASSERT_TRUE(cap.available());
+    ASSERT_EQ(cap.size(), 7U);
+    EXPECT_EQ(cap.triggerIndex(), 4U);
+    const int16_t expected[] = {46, 47, 48, 49, 200, 201, 202};
+    for (size_t i = 0; i < cap.size(); ++i) {
+        EXPECT_EQ(cap.data()[i], expected[i]) << i;
+    }
+
+    // Second bank keeps running, but trigger is missed until released
+    EXPECT_FALSE(cap.push(0));
+    EXPECT_FALSE(cap.push(150));
+    EXPECT_EQ(cap.missed(), 1U);
+    EXPECT_EQ(cap.data()[4], 200);
+
+    cap.release();
+    EXPECT_FALSE(cap.available());
+    EXPECT_FALSE(cap.push(0));
+    EXPECT_FALSE(cap.push(150));
+    EXPECT_FALSE(cap.push(151));
+    EXPECT_TRUE(cap.push(152));
+    ASSERT_EQ(cap.size(), 6U);  // Only 3 pre-trigger samples in this bank
+    EXPECT_EQ(cap.triggerIndex(), 3U);
+    EXPECT_EQ(cap.data()[3], 150);
+    EXPECT_EQ(cap.count(), 2U);
+}
+
+TEST(Capture, ShortPre)
+{
+    Capture cap{};
+    CaptureConfig cfg{};
+    cfg.trigger    = Trigger::Software;
+    cfg.pre        = 8;
+    cfg.post       = 2;
+    cfg.auto_rearm = false;
+    EXPECT_TRUE(cap.config(cfg));
+    cap.arm();
+
+    EXPECT_FALSE(cap.push(1));
+    EXPECT_FALSE(cap.push(1000));  // No trigger by level
+    cap.trigger();
+    EXPECT_FALSE(cap.push(2));
+    EXPECT_TRUE(cap.push(3));
+    EXPECT_FALSE(cap.armed());
+
+    ASSERT_EQ(cap.size(), 4U);
+    EXPECT_EQ(cap.triggerIndex(), 2U);
+    const int16_t expected[] = {1, 1000, 2, 3};
+    for (size_t i = 0; i < cap.size(); ++i) {
+        EXPECT_EQ(cap.data()[i], expected[i]) << i;
+    }
+}
+
+TEST(Capture, Level)
+{
+    Capture cap{};
+    CaptureConfig cfg{};
+    cfg.trigger = Trigger::Below;
+    cfg.level   = -10;
+    cfg.pre     = 0;
+    cfg.post    = 1;
+    EXPECT_TRUE(cap.config(cfg));
+    cap.arm();
+
+    EXPECT_FALSE(cap.push(0));
+    EXPECT_TRUE(cap.push(-10));
+    ASSERT_EQ(cap.size(), 1U);
+    EXPECT_EQ(cap.data()[0], -10);
+}
@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for Comparator
+*/
+#include <gtest/gtest.h>
+#include <utility/comparator.hpp>
+
+using namespace m5::unit::anadig;
+using namespace m5::unit::anadig::comparator;
+
+TEST(Comparator, Disabled)
+{
+    Comparator cmp{};
+    EXPECT_FALSE(cmp.enabled());
+    for (int32_t v = -32768; v < 32768; v += 1024) {
+        EXPECT_EQ(cmp.evaluate(v), 0U);
+    }
+    EXPECT_EQ(cmp.state(), 0U);
+}
+
+TEST(Comparator, High)
+{
+    Threshold th{};
+    th.enable_high = true;
+    th.high        = 1000;
+    th.hysteresis  = 100;
+    Comparator cmp(th);
+
+    EXPECT_EQ(cmp.evaluate(999), 0U);
+    EXPECT_EQ(cmp.evaluate(1000), EVENT_ENTER_HIGH);
+    EXPECT_EQ(cmp.state(), STATE_HIGH);
+    // Within hysteresis
+    EXPECT_EQ(cmp.evaluate(901), 0U);
+    EXPECT_EQ(cmp.evaluate(900), 0U);
+    EXPECT_EQ(cmp.state(), STATE_HIGH);
+    EXPECT_EQ(cmp.evaluate(899), EVENT_LEAVE_HIGH);
+    EXPECT_EQ(cmp.state(), 0U);
+}
+
+TEST(Comparator, Debounce)
+{
+    Threshold th{};
+    th.enable_low = true;
+    th.low        = -500;
+    th.debounce   = 3;
+    Comparator cmp(th);
+
+    EXPECT_EQ(cmp.evaluate(-600), 0U);
+    EXPECT_EQ(cmp.evaluate(-600), 0U);
+    EXPECT_EQ(cmp.evaluate(0), 0U);  // Counter is cleared
+    EXPECT_EQ(cmp.evaluate(-600), 0U);
+    EXPECT_EQ(cmp.evaluate(-600), 0U);
+    EXPECT_EQ(cmp.evaluate(-600), EVENT_ENTER_LOW);
+    EXPECT_EQ(cmp.state(), STATE_LOW);
+
+    EXPECT_EQ(cmp.evaluate(0), 0U);
+    EXPECT_EQ(cmp.evaluate(0), 0U);
+    EXPECT_EQ(cmp.evaluate(0), EVENT_LEAVE_LOW);
+    EXPECT_EQ(cmp.state(), 0U);
+}
+
+TEST(Comparator, Window)
+{
+    Threshold th{};
+    th.enable_low  = true;
+    th.enable_high = true;
+    th.low         = -32768;  // Extremes must not overflow
+    th.high        = 32767;
+    th.hysteresis  = 0xFFFF;
+    Comparator cmp(th);
+    EXPECT_EQ(cmp.state(), STATE_INSIDE);
+    EXPECT_EQ(cmp.evaluate(-32768), EVENT_ENTER_LOW | EVENT_LEAVE_WINDOW);
+    EXPECT_EQ(cmp.evaluate(32767), EVENT_ENTER_HIGH);
+    EXPECT_EQ(cmp.state(), STATE_LOW | STATE_HIGH);
+
+    th.low        = 0;
+    th.high       = 100;
+    th.hysteresis = 10;
+    cmp.config(th);
+    EXPECT_EQ(cmp.state(), STATE_INSIDE);
+    EXPECT_EQ(cmp.evaluate(50), 0U);
+    EXPECT_EQ(cmp.evaluate(100), EVENT_ENTER_HIGH | EVENT_LEAVE_WINDOW);
+    EXPECT_EQ(cmp.state(), STATE_HIGH);
+    EXPECT_EQ(cmp.evaluate(95), 0U);
+    EXPECT_EQ(cmp.evaluate(89), EVENT_LEAVE_HIGH | EVENT_ENTER_WINDOW);
+    EXPECT_EQ(cmp.state(), STATE_INSIDE);
+    EXPECT_EQ(cmp.evaluate(0), EVENT_ENTER_LOW | EVENT_LEAVE_WINDOW);
+    EXPECT_EQ(cmp.evaluate(10), 0U);
+    EXPECT_EQ(cmp.evaluate(11), EVENT_LEAVE_LOW | EVENT_ENTER_WINDOW);
+}
@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for Deadband
+*/
+#include <gtest/gtest.h>
+#include <utility/deadband.hpp>
+
+using namespace m5::unit::anadig;
+
+TEST(Deadband, Basic)
+{
+    Deadband db{};
+    DeadbandConfig cfg{};
+    cfg.enable         = true;
+    cfg.deadband       = 10;
+    cfg.max_silence_ms = 1000;
+    db.config(cfg);
+
+    uint32_t now{};
+    EXPECT_TRUE(db.pass(0, now));  // First sample
+    EXPECT_FALSE(db.pass(10, ++now));
+    EXPECT_FALSE(db.pass(-10, ++now));
+    EXPECT_TRUE(db.pass(11, ++now));
+    EXPECT_FALSE(db.pass(1, ++now));
+    EXPECT_TRUE(db.pass(0, ++now));
+
+    // Silence
+    EXPECT_FALSE(db.pass(0, now + 999));
+    EXPECT_TRUE(db.pass(0, now + 1000));
+
+    EXPECT_EQ(db.received(), 8U);
+    EXPECT_EQ(db.reported(), 4U);
+    EXPECT_FLOAT_EQ(db.ratio(), 2.0f);
+
+    // Extremes
+    db.reset();
+    EXPECT_EQ(db.received(), 0U);
+    EXPECT_FLOAT_EQ(db.ratio(), 0.0f);
+    EXPECT_TRUE(db.pass(-32768, now));
+    EXPECT_TRUE(db.pass(32767, now));
+    EXPECT_TRUE(db.pass(-32768, now));
+}
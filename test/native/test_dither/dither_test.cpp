@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for SigmaDelta
+*/
+#include <gtest/gtest.h>
+#include <utility/dither.hpp>
+#include <utility/fixed_point.hpp>
+#include <cstdlib>
+
+using namespace m5::unit::anadig;
+
+TEST(Dither, Average)
+{
+    SigmaDelta sd;
+
+    for (uint32_t frac = 0; frac < 256; ++frac) {
+        SCOPED_TRACE(frac);
+        sd.reset();
+        sd.setTarget((1000U << 8) | frac, 4095);
+        EXPECT_EQ(sd.fractional(), frac != 0);
+
+        uint32_t sum{};
+        for (int i = 0; i < 256; ++i) {
+            auto c = sd.next();
+            EXPECT_TRUE(c == 1000 || c == 1001);
+            sum += c;
+        }
+        // Exact over 256 cycles
+        EXPECT_EQ(sum, 1000U * 256U + frac);
+    }
+}
+
+TEST(Dither, Bounded)
+{
+    SigmaDelta sd;
+
+    // Clamped
+    sd.setTarget(5000U << 8, 4095);
+    EXPECT_EQ(sd.target(), 4095U << 8);
+    EXPECT_FALSE(sd.fractional());
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_EQ(sd.next(), 4095);
+    }
+    sd.setTarget((4094U << 8) | 255, 4095);
+    for (int i = 0; i < 256; ++i) {
+        EXPECT_LE(sd.next(), 4095);
+    }
+
+    // Error is bounded after changing the target
+    sd.setTarget((100U << 8) | 64, 4095);
+    int32_t sum{}, n{};
+    for (int i = 0; i < 100; ++i) {
+        sum += sd.next();
+        ++n;
+        const int32_t err = sum * 256 - n * ((100 << 8) | 64);
+        EXPECT_LT(std::abs(err), 256);
+    }
+}
+
+TEST(Dither, CodeScale)
+{
+    const CodeScale s(4095, 3300 * 1000U, 3300 * 1000U);
+    for (int32_t uv = 0; uv <= 3300 * 1000; uv += 997) {
+        SCOPED_TRACE(uv);
+        auto q8 = s.to_code_q8(uv);
+        EXPECT_EQ(q8 >> 8, s.to_code(uv));
+        const double exact = (double)uv * 4095 * 256 / (3300 * 1000);
+        EXPECT_NEAR((double)q8, exact, 1.0);
+    }
+    EXPECT_EQ(s.to_code_q8(-1), 0U);
+    EXPECT_EQ(s.to_code_q8(4000 * 1000), 4095U << 8);
+}
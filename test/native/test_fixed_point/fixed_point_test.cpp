@@ -0,0 +1,133 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for integer conversion
+*/
+#include <gtest/gtest.h>
+#include <utility/fixed_point.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+using namespace m5::unit::anadig;
+
+namespace {
+constexpr int32_t min_code_table[] = {-2048, -8192, -16384, -32768};
+constexpr float factor_table[]     = {1.0f, 0.25f, 100.f / 610.f};
+constexpr float vdd_table[]        = {2048.f, 3300.f};
+
+}  // namespace
+
+TEST(FixedPoint, ADC)
+{
+    for (auto&& mc : min_code_table) {
+        for (uint8_t gs = 0; gs < 4; ++gs) {
+            for (auto&& vdd : vdd_table) {
+                for (auto&& factor : factor_table) {
+                    auto s = testing::Message() << "MC:" << mc << " GS:" << (int)gs << " VDD:" << vdd
+                                                << " F:" << factor;
+                    SCOPED_TRACE(s);
+
+                    const uint32_t lsb = adc_lsb_microvoltage_q16(mc, gs, vdd, factor);
+                    const double exact_lsb =
+                        static_cast<double>(vdd) * 1000.0 / (-static_cast<double>(mc) * (1U << gs) * factor);
+                    for (int32_t v = mc; v < -mc; ++v) {
+                        const int32_t uv = adc_code_to_microvoltage(static_cast<int16_t>(v), lsb);
+                        // Less than 1 uV against the exact value
+                        EXPECT_LT(std::fabs(uv - v * exact_lsb), 1.0) << v;
+                        // Float path is within own precision
+                        const float mv = adc_code_to_voltage(static_cast<int16_t>(v), mc, gs, vdd, factor);
+                        EXPECT_LE(std::fabs(uv - mv * 1000.0), std::fabs(mv) * 1000.0 * 2.4e-7 + 1.0) << v;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(FixedPoint, DAC)
+{
+    struct Param {
+        uint16_t max_code;
+        float full_mv;
+        float clamp_mv;
+    };
+    constexpr Param table[] = {
+        {0x0FFF, 5000.f, 3300.f},    // MCP4725
+        {0x0FFF, 3300.f, 3300.f},    // MCP4725 (3.3V supply)
+        {0x7FFF, 5000.f, 5000.f},    // GP8413 5V
+        {0x7FFF, 10000.f, 10000.f},  // GP8413 10V
+    };
+
+    for (auto&& p : table) {
+        auto s = testing::Message() << "MAX:" << p.max_code << " FULL:" << p.full_mv;
+        SCOPED_TRACE(s);
+
+        const CodeScale scale(p.max_code, static_cast<uint32_t>(p.full_mv * 1000),
+                              static_cast<uint32_t>(p.clamp_mv * 1000));
+
+        // Voltage to code, within 1 code
+        for (int32_t uv = -1000; uv <= static_cast<int32_t>(p.full_mv * 1000) + 1000; uv += 37) {
+            const int32_t ic = scale.to_code(uv);
+            const int32_t fc = dac_voltage_to_code(uv / 1000.f, p.clamp_mv, p.full_mv, p.max_code);
+            EXPECT_LE(std::abs(ic - fc), 1) << uv;
+        }
+        // Code to voltage, within 1 uV
+        for (uint32_t c = 0; c <= p.max_code; ++c) {
+            const double exact = static_cast<double>(c) * p.full_mv * 1000.0 / p.max_code;
+            EXPECT_LT(std::fabs(scale.to_microvoltage(c) - exact), 1.0) << c;
+            EXPECT_NEAR(scale.to_microvoltage(c), dac_code_to_voltage(c, p.full_mv, p.max_code) * 1000.f,
+                        1.0 + exact * 1.2e-7)
+                << c;
+        }
+        // Round trip (to_microvoltage rounds to nearest, to_code truncates as float path)
+        for (uint32_t c = 0; c <= p.max_code; ++c) {
+            const int32_t uv = scale.to_microvoltage(c) + 1;
+            if (uv <= static_cast<int32_t>(scale.clamp_uv)) {
+                EXPECT_EQ(scale.to_code(uv), c);
+            }
+        }
+    }
+}
+
+TEST(FixedPoint, MilliToMicro)
+{
+    EXPECT_EQ(mv_to_microvoltage(0.f), 0);
+    EXPECT_EQ(mv_to_microvoltage(1.2345f), 1235);
+    EXPECT_EQ(mv_to_microvoltage(-1.2345f), -1235);
+    EXPECT_EQ(mv_to_microvoltage(3300.f), 3300000);
+    EXPECT_EQ(mv_to_microvoltage(std::numeric_limits<float>::quiet_NaN()), 0);
+    EXPECT_EQ(mv_to_microvoltage(1e9f), INT32_MAX);
+    EXPECT_EQ(mv_to_microvoltage(-1e9f), INT32_MIN);
+    EXPECT_EQ(mv_to_microvoltage(std::numeric_limits<float>::infinity()), INT32_MAX);
+    EXPECT_EQ(mv_to_microvoltage(-std::numeric_limits<float>::infinity()), INT32_MIN);
+}
+
+TEST(FixedPoint, FloatCodeScale)
+{
+    for (auto&& full : {5000.f, 10000.f}) {
+        SCOPED_TRACE(full);
+        const FloatCodeScale scale(0x7FFF, full, full);
+
+        std::vector<float> mv;
+        for (float v = -10.f; v <= full + 10.f; v += 0.173f) {
+            mv.push_back(v);
+        }
+        mv.push_back(std::nanf(""));
+
+        std::vector<uint16_t> codes(mv.size());
+        scale.to_codes(codes.data(), mv.data(), mv.size());
+        for (size_t i = 0; i < mv.size() - 1; ++i) {
+            const int32_t rc = dac_voltage_to_code(mv[i], full, full, 0x7FFF);
+            EXPECT_LE(std::abs(scale.to_code(mv[i]) - rc), 1) << mv[i];
+            EXPECT_EQ(codes[i], scale.to_code(mv[i])) << mv[i];  // Batch is the same as the single
+        }
+        EXPECT_EQ(codes.back(), 0U);  // NaN
+        EXPECT_EQ(scale.to_code(full), 0x7FFF);
+        EXPECT_EQ(scale.to_code(full * 2), 0x7FFF);
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for hum
+*/
+#include <gtest/gtest.h>
+#include <utility/hum.hpp>
+#include <cmath>
+
+using namespace m5::unit::anadig;
+
+namespace {
+constexpr double PI{3.14159265358979323846};
+
+// DC with hum at 240 SPS
+int16_t sample(const uint32_t n, const int32_t dc, const double amp, const double freq, const double fs = 240.0)
+{
+    return static_cast<int16_t>(std::lround(dc + amp * std::sin(2.0 * PI * freq * n / fs + 0.3)));
+}
+}  // namespace
+
+TEST(Hum, Window)
+{
+    EXPECT_EQ(hum_window(240.f, 50.f), 24U);
+    EXPECT_EQ(hum_window(240.f, 60.f), 4U);
+    EXPECT_EQ(hum_window(240.f, 10.f), 24U);  // Both 50 and 60Hz
+    EXPECT_EQ(hum_window(128.f, 50.f), 64U);
+    EXPECT_EQ(hum_window(32.f, 50.f), 16U);  // Aliased to 14Hz
+    EXPECT_EQ(hum_window(15.f, 60.f), 0U);   // Aliased to DC
+    EXPECT_EQ(hum_window(0.f, 50.f), 0U);
+}
+
+TEST(Hum, Goertzel)
+{
+    Goertzel g{};
+    EXPECT_FALSE(g.push(0));
+    EXPECT_FALSE(g.begin(240.f, 50.f, 1));
+    EXPECT_FALSE(g.begin(240.f, 50.f, Goertzel::MAX_BLOCK + 1));
+    EXPECT_TRUE(g.begin(240.f, 50.f, 24));
+
+    for (auto&& amp : {0.0, 10.0, 500.0, 12000.0}) {
+        uint32_t n{};
+        for (uint32_t b = 0; b < 4; ++b) {
+            for (uint32_t i = 0; i < 23; ++i) {
+                EXPECT_FALSE(g.push(sample(n++, 3000, amp, 50.0)));
+            }
+            EXPECT_TRUE(g.push(sample(n++, 3000, amp, 50.0)));
+            EXPECT_NEAR(g.amplitude() / 256.0, amp, 1.0) << amp;
+        }
+    }
+    EXPECT_EQ(g.blocks(), 16U);
+
+    // Other frequency is not detected
+    uint32_t n{};
+    while (!g.push(sample(n++, 0, 1000.0, 60.0))) {
+    }
+    EXPECT_LT(g.amplitude() / 256.0, 1.0);
+
+    // Aliased
+    EXPECT_TRUE(g.begin(32.f, 50.f, 16));
+    n = 0;
+    while (!g.push(sample(n++, 100, 800.0, 50.0, 32.0))) {
+    }
+    EXPECT_NEAR(g.amplitude() / 256.0, 800.0, 1.0);
+}
+
+TEST(Hum, Notch)
+{
+    Notch f{};
+    EXPECT_EQ(f.process(123), 123);            // Not set up
+    EXPECT_FALSE(f.begin(240.f, 240.f, 4.f));  // DC
+    EXPECT_FALSE(f.begin(240.f, 50.f, 100.f));
+    EXPECT_TRUE(f.begin(240.f, 50.f, 4.f));
+
+    // Steady state from the first sample
+    for (uint32_t i = 0; i < 16; ++i) {
+        EXPECT_EQ(f.process(-1234), -1234);
+    }
+
+    f.reset();
+    double peak{};
+    for (uint32_t n = 0; n < 2400; ++n) {
+        const int16_t y = f.process(sample(n, 3000, 2000.0, 50.0));
+        if (n >= 240) {
+            peak = std::fmax(peak, std::fabs(y - 3000.0));
+        }
+    }
+    EXPECT_LT(peak, 20.0);  // > 40dB
+
+    // Passes other frequencies
+    f.reset();
+    peak = 0.0;
+    for (uint32_t n = 0; n < 2400; ++n) {
+        const int16_t y = f.process(sample(n, 0, 2000.0, 5.0));
+        if (n >= 240) {
+            peak = std::fmax(peak, std::fabs((double)y));
+        }
+    }
+    EXPECT_GT(peak, 1900.0);
+}
+
+TEST(Hum, SyncAverage)
+{
+    SyncAverage f{};
+    EXPECT_EQ(f.process(42), 42);  // Not set up
+    EXPECT_FALSE(f.begin(0));
+    EXPECT_TRUE(f.begin(hum_window(240.f, 10.f)));
+
+    for (auto&& freq : {50.0, 60.0, 100.0, 120.0}) {
+        f.reset();
+        for (uint32_t n = 0; n < 240; ++n) {
+            const int16_t y = f.process(sample(n, -5000, 3000.0, freq));
+            if (n >= 24) {
+                EXPECT_NEAR(y, -5000, 1) << freq << ":" << n;
+            }
+        }
+    }
+}
+
+TEST(Hum, Rejector)
+{
+    HumRejector r{};
+    HumConfig cfg{};
+    EXPECT_TRUE(r.begin(240.f, cfg));  // Disabled
+    EXPECT_FALSE(r.enabled());
+    EXPECT_EQ(r.process(77), 77);
+
+    cfg.enable = true;
+    cfg.freq   = 60.f;
+    EXPECT_FALSE(r.begin(15.f, cfg));  // 60Hz is rejected by the ADC at 15 SPS
+    EXPECT_FALSE(r.enabled());
+    cfg.freq = 50.f;
+
+    for (auto&& filter : {HumFilter::None, HumFilter::Notch, HumFilter::Average}) {
+        cfg.filter = filter;
+        EXPECT_TRUE(r.begin(240.f, cfg));
+        EXPECT_TRUE(r.enabled());
+        EXPECT_EQ(r.detector().block(), 240U);  // 10 periods
+
+        double peak{};
+        for (uint32_t n = 0; n < 480; ++n) {
+            const int16_t x = sample(n, 1000, 400.0, 50.0);
+            const int16_t y = r.process(x);
+            if (n >= 240) {
+                peak = std::fmax(peak, std::fabs(y - 1000.0));
+            }
+        }
+        EXPECT_NEAR(r.detector().amplitude() / 256.0, 400.0, 1.0);
+        if (filter == HumFilter::None) {
+            EXPECT_GT(peak, 390.0);
+        } else {
+            EXPECT_LT(peak, 5.0);
+        }
+    }
+}
@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for linearity
+*/
+#include <gtest/gtest.h>
+#include <utility/linearity.hpp>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+using namespace m5::unit::anadig;
+
+namespace {
+// DAC with gain/offset error and a bow
+int32_t transfer(const uint16_t code)
+{
+    const double x = code / 4095.0;
+    return static_cast<int32_t>(std::lround(20000.0 + 3250000.0 * x + 8000.0 * x * (1.0 - x)));
+}
+
+std::vector<LinearityPoint> sweep(const uint16_t step)
+{
+    std::vector<LinearityPoint> v;
+    for (uint32_t c = 0; c <= 4095; c += step) {
+        v.push_back(LinearityPoint{static_cast<uint16_t>(c), transfer(c)});
+    }
+    if (v.back().code != 4095) {
+        v.push_back(LinearityPoint{4095, transfer(4095)});
+    }
+    return v;
+}
+}  // namespace
+
+TEST(Linearity, Analyze)
+{
+    LinearityResult r{};
+    EXPECT_FALSE(analyze_linearity(nullptr, 0, r));
+
+    // Ideal
+    std::vector<LinearityPoint> ideal{{0, 0}, {1000, 1000000}, {2000, 2000000}};
+    ASSERT_TRUE(analyze_linearity(ideal.data(), ideal.size(), r));
+    EXPECT_FLOAT_EQ(r.slope, 1000.f);
+    EXPECT_NEAR(r.offset, 0.f, 1e-3f);
+    EXPECT_NEAR(r.inl_max, 0.f, 1e-5f);
+    EXPECT_NEAR(r.step_error_max, 0.f, 1e-5f);
+
+    // Bow of 2mV at the center
+    auto pts = sweep(128);
+    std::vector<float> inl(pts.size()), step(pts.size() - 1);
+    ASSERT_TRUE(analyze_linearity(pts.data(), pts.size(), r, inl.data(), step.data()));
+    EXPECT_NEAR(r.slope, 3250000.f / 4095.f, 1.f);
+    const float lsb = r.slope;
+    EXPECT_NEAR(r.inl_max, 8000.f / 6.f / lsb, 0.1f);  // Largest at the ends against the fit line
+    EXPECT_GT(inl[pts.size() / 2], 0.f);
+    EXPECT_LT(inl.front(), 0.f);
+    EXPECT_GT(r.step_error_max, 0.f);
+    EXPECT_LT(r.step_error_min, 0.f);
+    EXPECT_FLOAT_EQ(r.step_error_max, *std::max_element(step.begin(), step.end()));
+
+    // DNL on consecutive codes, the code 1004 is missing (Same output as 1003)
+    std::vector<LinearityPoint> dense{};
+    for (uint16_t c = 1000; c <= 1008; ++c) {
+        dense.push_back({c, static_cast<int32_t>((c == 1004 ? 1003 : c) * 1000)});
+    }
+    ASSERT_TRUE(analyze_linearity(dense.data(), dense.size(), r, nullptr, step.data()));
+    EXPECT_NEAR(step[3], -1.f, 0.2f);
+    EXPECT_NEAR(step[4], 1.f, 0.2f);
+    EXPECT_NEAR(r.step_error_min, -1.f, 0.2f);
+}
+
+TEST(Linearity, DacCorrection)
+{
+    DacCorrection dc;
+    EXPECT_FALSE(dc.valid());
+    EXPECT_EQ(dc.to_code(1000), 0U);
+
+    std::vector<LinearityPoint> bad{{0, 100}, {100, 50}};
+    EXPECT_FALSE(dc.build(bad.data(), bad.size(), 4095));
+
+    auto pts = sweep(128);
+    ASSERT_TRUE(dc.build(pts.data(), pts.size(), 4095));
+    EXPECT_EQ(dc.size(), pts.size());
+
+    // Corrected code reaches the target within 1 code in the real transfer
+    const double lsb = 3250000.0 / 4095;
+    for (int32_t uv = 30000; uv < 3260000; uv += 7919) {
+        auto c = dc.to_code(uv);
+        EXPECT_LE(std::abs(transfer(c) - uv), 1.5 * lsb) << uv;
+        EXPECT_NEAR(dc.to_microvoltage(c), uv, lsb) << uv;
+    }
+    // Q8 agrees with the rounded code
+    for (int32_t uv = 30000; uv < 3260000; uv += 7919) {
+        EXPECT_NEAR((dc.to_code_q8(uv) + 128) >> 8, dc.to_code(uv), 1) << uv;
+    }
+    // Clamped
+    EXPECT_EQ(dc.to_code(0), 0U);
+    EXPECT_EQ(dc.to_code(5000000), 4095U);
+    EXPECT_EQ(dc.to_code_q8(0), 0U);
+    EXPECT_EQ(dc.to_code_q8(5000000), 4095U << 8);
+
+    // Extrapolated past a shallow end segment beyond int32_t, then clamped
+    std::vector<LinearityPoint> shallow{{0, 0}, {100, 1000000}, {200, 1000001}};
+    DacCorrection sc{};
+    ASSERT_TRUE(sc.build(shallow.data(), shallow.size(), 4095));
+    EXPECT_EQ(sc.to_code(2000000000), 4095U);
+    EXPECT_EQ(sc.to_code_q8(2000000000), 4095U << 8);
+    EXPECT_EQ(sc.to_code(-2000000000), 0U);
+    EXPECT_EQ(dc.to_microvoltage(0), pts.front().uv);
+    EXPECT_EQ(dc.to_microvoltage(4095), pts.back().uv);
+
+    std::vector<LinearityPoint> many(DacCorrection::MAX_POINTS + 1);
+    EXPECT_FALSE(dc.build(many.data(), many.size(), 4095));
+    EXPECT_FALSE(dc.valid());
+}
+
+TEST(Linearity, AdcCorrection)
+{
+    // ADC reads 2% high with +5mV offset against the nominal DAC
+    const CodeScale dac(4095, 3300 * 1000U, 3300 * 1000U);
+    std::vector<LinearityPoint> pts;
+    for (uint16_t c = 0; c <= 4095; c += 256) {
+        pts.push_back(LinearityPoint{c, static_cast<int32_t>(dac.to_microvoltage(c) * 1.02 + 5000)});
+    }
+    GainOffset g{};
+    EXPECT_TRUE(g.identity());
+    ASSERT_TRUE(adc_correction(pts.data(), pts.size(), dac, g));
+    EXPECT_FALSE(g.identity());
+    for (auto&& p : pts) {
+        EXPECT_NEAR(g.apply(p.uv), dac.to_microvoltage(p.code), 2);
+    }
+}
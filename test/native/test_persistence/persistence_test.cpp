@@ -0,0 +1,167 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for PersistenceManager
+*/
+#include <gtest/gtest.h>
+#include <utility/persistence.hpp>
+#include <vector>
+
+using namespace m5::unit::anadig;
+
+namespace {
+struct Device {
+    std::vector<uint16_t> written;
+    bool busy{}, fail{};
+};
+}  // namespace
+
+TEST(Persistence, Basic)
+{
+    Device dev;
+    PersistenceManager pm;
+
+    EXPECT_FALSE(pm.begin(0, [](const uint16_t*, const uint8_t) { return true; }, nullptr, 100));
+    EXPECT_FALSE(pm.begin(PersistenceManager::MAX_VALUES + 1, [](const uint16_t*, const uint8_t) { return true; },
+                          nullptr, 100));
+    EXPECT_FALSE(pm.begin(1, nullptr, nullptr, 100));
+
+    ASSERT_TRUE(pm.begin(
+        1,
+        [&dev](const uint16_t* v, const uint8_t num) {
+            EXPECT_EQ(num, 1U);
+            if (dev.fail) {
+                return false;
+            }
+            dev.written.push_back(v[0]);
+            dev.busy = true;
+            return true;
+        },
+        [&dev]() { return dev.busy; }, 100));
+    EXPECT_FALSE(pm.known());
+
+    const uint16_t eeprom{1000};
+    pm.setStored(&eeprom);
+    EXPECT_TRUE(pm.known());
+    EXPECT_EQ(pm.stored(0), 1000U);
+
+    uint32_t now{};
+    // Same as stored
+    pm.request(&eeprom, now);
+    EXPECT_FALSE(pm.pending());
+    EXPECT_EQ(pm.skipped(), 1U);
+
+    // Rapid changes are coalesced
+    for (uint16_t v = 1; v <= 10; ++v) {
+        pm.request(&v, now);
+        now += 10;
+        EXPECT_FALSE(pm.update(now));
+    }
+    EXPECT_TRUE(pm.pending());
+    EXPECT_EQ(pm.coalesced(), 9U);
+    EXPECT_FALSE(pm.update(now + 89));
+    EXPECT_TRUE(pm.update(now + 90));
+    EXPECT_FALSE(pm.pending());
+    ASSERT_EQ(dev.written.size(), 1U);
+    EXPECT_EQ(dev.written[0], 10U);
+    EXPECT_EQ(pm.stored(0), 10U);
+    EXPECT_EQ(pm.writes(), 1U);
+    now += 90;
+
+    // Waiting for the device
+    uint16_t v{20};
+    pm.request(&v, now);
+    EXPECT_FALSE(pm.update(now += 100));
+    EXPECT_TRUE(pm.pending());
+    dev.busy = false;
+    EXPECT_TRUE(pm.update(now += 1));
+    EXPECT_EQ(dev.written.back(), 20U);
+
+    // Back to the stored value cancels the pending request
+    v = 30;
+    pm.request(&v, now);
+    v = 20;
+    pm.request(&v, now);
+    EXPECT_FALSE(pm.pending());
+    EXPECT_FALSE(pm.update(now += 1000));
+
+    // Failure and retry
+    dev.busy = false;
+    dev.fail = true;
+    v        = 40;
+    pm.request(&v, now);
+    EXPECT_FALSE(pm.flush(now));
+    EXPECT_EQ(pm.failed(), 1U);
+    EXPECT_TRUE(pm.pending());
+    dev.fail = false;
+    EXPECT_FALSE(pm.update(now + 99));
+    EXPECT_TRUE(pm.update(now + 100));
+    EXPECT_EQ(dev.written.back(), 40U);
+
+    EXPECT_EQ(pm.writes(), 3U);
+    EXPECT_EQ(pm.requests(), 15U);
+
+    // Asynchronous write failed after it has been started
+    now += 100;
+    dev.busy = false;
+    pm.complete(false, now);
+    EXPECT_EQ(pm.failed(), 2U);
+    EXPECT_FALSE(pm.known());
+    EXPECT_TRUE(pm.pending());
+    pm.request(&v, now);  // Not skipped as already stored
+    EXPECT_TRUE(pm.pending());
+    EXPECT_EQ(pm.skipped(), 2U);
+    EXPECT_TRUE(pm.update(now + 100));
+    EXPECT_EQ(dev.written.back(), 40U);
+    pm.complete(true, now + 200);
+    EXPECT_TRUE(pm.known());
+    EXPECT_FALSE(pm.pending());
+
+    // A newer request is kept
+    dev.busy = false;
+    v        = 50;
+    pm.request(&v, now);
+    EXPECT_TRUE(pm.flush(now));
+    v = 60;
+    pm.request(&v, now);
+    dev.busy = false;
+    pm.complete(false, now);
+    EXPECT_TRUE(pm.update(now + 100));
+    EXPECT_EQ(dev.written.back(), 60U);
+}
+
+TEST(Persistence, Unknown)
+{
+    uint32_t writes{};
+    PersistenceManager pm;
+    ASSERT_TRUE(pm.begin(
+        2,
+        [&writes](const uint16_t*, const uint8_t num) {
+            EXPECT_EQ(num, 2U);
+            ++writes;
+            return true;
+        },
+        nullptr, 0));
+
+    // Always written if unknown
+    const uint16_t v[2]{1, 2};
+    pm.request(v, 0);
+    EXPECT_TRUE(pm.update(0));
+    EXPECT_TRUE(pm.known());
+    pm.request(v, 0);
+    EXPECT_FALSE(pm.update(0));
+    EXPECT_EQ(writes, 1U);
+
+    const uint16_t w[2]{1, 3};
+    pm.request(w, 0);
+    EXPECT_TRUE(pm.update(0));
+    EXPECT_EQ(pm.stored(1), 3U);
+
+    pm.invalidate();
+    pm.request(w, 0);
+    EXPECT_TRUE(pm.update(0));
+    EXPECT_EQ(writes, 3U);
+}
@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for Pid
+*/
+#include <gtest/gtest.h>
+#include <utility/pid.hpp>
+
+using namespace m5::unit::anadig;
+
+namespace {
+// First-order plant y += (u - y) * alpha
+struct Plant {
+    int32_t y{};
+    int32_t step(const int32_t u)
+    {
+        y += (u - y) / 4;
+        return y;
+    }
+};
+}  // namespace
+
+TEST(Pid, Proportional)
+{
+    PidConfig cfg{};
+    cfg.kp_q16  = Pid::gain(2.0f);
+    cfg.out_min = -1000000;
+    cfg.out_max = 1000000;
+    Pid pid;
+    pid.config(cfg);
+
+    EXPECT_EQ(Pid::gain(1.0f), 65536);
+    EXPECT_EQ(Pid::gain(-0.5f), -32768);
+
+    EXPECT_EQ(pid.step(1000, 0), 2000);
+    EXPECT_EQ(pid.step(0, 1000), -2000);
+    EXPECT_FALSE(pid.saturated());
+
+    // Limits
+    EXPECT_EQ(pid.step(1000000, 0), 1000000);
+    EXPECT_TRUE(pid.saturated());
+    EXPECT_EQ(pid.step(-1000000, 0), -1000000);
+    EXPECT_TRUE(pid.saturated());
+}
+
+TEST(Pid, Converge)
+{
+    PidConfig cfg{};
+    cfg.kp_q16  = Pid::gain(0.5f);
+    cfg.ki_q16  = Pid::gain(0.2f);
+    cfg.out_min = 0;
+    cfg.out_max = 5000000;
+    Pid pid;
+    pid.config(cfg);
+    Plant plant;
+
+    int32_t y{};
+    for (int i = 0; i < 500; ++i) {
+        y = plant.step(pid.step(1234567, y));
+    }
+    EXPECT_NEAR(y, 1234567, 10);
+    EXPECT_NEAR(pid.integral(), 1234567, 100);  // Integral holds the steady state output
+}
+
+TEST(Pid, AntiWindup)
+{
+    PidConfig cfg{};
+    cfg.kp_q16  = Pid::gain(0.5f);
+    cfg.ki_q16  = Pid::gain(0.2f);
+    cfg.out_min = 0;
+    cfg.out_max = 1000000;
+    Pid pid;
+    pid.config(cfg);
+    Plant plant;
+
+    // Unreachable setpoint for a long time
+    int32_t y{};
+    for (int i = 0; i < 1000; ++i) {
+        y = plant.step(pid.step(3000000, y));
+    }
+    EXPECT_TRUE(pid.saturated());
+    EXPECT_LE(pid.integral(), 1000000);
+
+    // Recovers immediately when the setpoint becomes reachable
+    int steps{};
+    while (pid.step(500000, y) >= 1000000 && steps < 100) {
+        y = plant.step(pid.output());
+        ++steps;
+    }
+    EXPECT_LT(steps, 3);
+}
+
+TEST(Pid, Derivative)
+{
+    PidConfig cfg{};
+    cfg.kd_q16  = Pid::gain(1.0f);
+    cfg.out_min = -1000000;
+    cfg.out_max = 1000000;
+    Pid pid;
+
+    // On measurement: no kick on a setpoint change
+    pid.config(cfg);
+    EXPECT_EQ(pid.step(0, 0), 0);
+    EXPECT_EQ(pid.step(1000, 0), 0);
+    EXPECT_EQ(pid.step(1000, 100), -100);
+
+    // On error
+    cfg.derivative_on_measurement = false;
+    pid.config(cfg);
+    EXPECT_EQ(pid.step(0, 0), 0);
+    EXPECT_EQ(pid.step(1000, 0), 1000);
+
+    // Bumpless reset
+    cfg.ki_q16 = Pid::gain(0.1f);
+    pid.config(cfg);
+    pid.reset(12345);
+    EXPECT_EQ(pid.output(), 12345);
+    EXPECT_EQ(pid.step(0, 0), 12345);
+}
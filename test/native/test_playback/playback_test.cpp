@@ -0,0 +1,121 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for WavePlayer
+*/
+#include <gtest/gtest.h>
+#include <utility/playback.hpp>
+#include <vector>
+
+using namespace m5::unit::anadig;
+
+namespace {
+
+// Produces 0,1,2... up to total
+struct Counter {
+    uint16_t next{}, total{};
+    size_t produce(uint16_t* buf, const size_t cap)
+    {
+        size_t n{};
+        while (n < cap && next < total) {
+            buf[n++] = next++;
+        }
+        return n;
+    }
+};
+
+}  // namespace
+
+TEST(Playback, Basic)
+{
+    Counter src{0, 100};
+    std::vector<uint16_t> out;
+    WavePlayer player;
+
+    EXPECT_FALSE(player.start(0));
+    EXPECT_FALSE(player.begin(nullptr, [](uint16_t) { return true; }, 16, 1000));
+    EXPECT_FALSE(player.begin([&src](uint16_t* b, size_t c) { return src.produce(b, c); }, nullptr, 16, 1000));
+    EXPECT_FALSE(player.begin([&src](uint16_t* b, size_t c) { return src.produce(b, c); },
+                              [](uint16_t) { return true; }, 0, 1000));
+
+    ASSERT_TRUE(player.begin([&src](uint16_t* b, size_t c) { return src.produce(b, c); },
+                             [&out](uint16_t v) {
+                                 out.push_back(v);
+                                 return true;
+                             },
+                             16, 1000));
+    EXPECT_EQ(player.state(), WavePlayer::State::Idle);
+
+    uint32_t now = 0xFFFFF000;  // Wrap around during playback
+    EXPECT_TRUE(player.start(now));
+    EXPECT_TRUE(player.playing());
+    EXPECT_EQ(out.size(), 1U);  // First sample
+    EXPECT_EQ(player.refills(), 2U);
+
+    // Called 4 times per interval
+    for (int i = 0; i < 500 && player.playing(); ++i) {
+        now += 250;
+        player.update(now);
+    }
+    EXPECT_EQ(player.state(), WavePlayer::State::Finished);
+    ASSERT_EQ(out.size(), 100U);
+    for (uint16_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(out[i], i);
+    }
+    EXPECT_EQ(player.played(), 100U);
+    EXPECT_EQ(player.skipped(), 0U);
+    EXPECT_EQ(player.refills(), 100U / 16 + 2);  // Including the empty one
+
+    // Restart after the producer is rewound
+    src.next = 0;
+    out.clear();
+    EXPECT_TRUE(player.start(now));
+    player.stop();
+    player.update(now + 100000);
+    EXPECT_EQ(out.size(), 1U);
+
+    // No data
+    src.next = src.total;
+    EXPECT_FALSE(player.start(now));
+    EXPECT_FALSE(player.playing());
+}
+
+TEST(Playback, Stall)
+{
+    Counter src{0, 1000};
+    std::vector<uint16_t> out;
+    WavePlayer player;
+    ASSERT_TRUE(player.begin([&src](uint16_t* b, size_t c) { return src.produce(b, c); },
+                             [&out](uint16_t v) {
+                                 out.push_back(v);
+                                 return v != 500;
+                             },
+                             8, 100));
+
+    uint32_t now{};
+    EXPECT_TRUE(player.start(now));
+    player.update(now += 50);
+    EXPECT_EQ(out.size(), 1U);  // Not due yet
+
+    player.update(now += 50);  // 100
+    EXPECT_EQ(out.back(), 1U);
+
+    // Stall for 3.5ms (Across some buffers)
+    player.update(now += 3500);  // 3600
+    EXPECT_EQ(out.back(), 36U);
+    EXPECT_EQ(player.skipped(), 34U);
+
+    // Keep the timing
+    player.update(now += 100);
+    EXPECT_EQ(out.back(), 37U);
+    while (player.playing()) {
+        player.update(now += 100);
+    }
+    EXPECT_EQ(out.back(), 999U);
+    EXPECT_EQ(player.played() + player.failed(), out.size());
+    EXPECT_EQ(player.failed(), 1U);
+    EXPECT_EQ(player.played() + player.failed() + player.skipped(), 1000U);
+}
@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for Ramp
+*/
+#include <gtest/gtest.h>
+#include <utility/ramp.hpp>
+
+using namespace m5::unit::anadig;
+
+TEST(Ramp, Linear)
+{
+    Ramp r;
+    EXPECT_FALSE(r.active());
+
+    // 1000mV at 1000mV/s -> 1s
+    r.start(0, 1000000, 1000, false, 0);
+    EXPECT_TRUE(r.active());
+    EXPECT_EQ(r.target(), 1000000);
+    EXPECT_EQ(r.duration(), 1000000U);
+
+    EXPECT_EQ(r.update(0), 0);
+    EXPECT_NEAR(r.update(250000), 250000, 16);
+    EXPECT_NEAR(r.update(500000), 500000, 16);
+    EXPECT_TRUE(r.active());
+    EXPECT_EQ(r.update(1000000), 1000000);
+    EXPECT_FALSE(r.active());
+    EXPECT_EQ(r.update(2000000), 1000000);
+
+    // Downward
+    r.start(1000000, 500000, 500, false, 0);
+    EXPECT_EQ(r.duration(), 1000000U);
+    EXPECT_NEAR(r.update(500000), 750000, 16);
+    EXPECT_EQ(r.update(1000000), 500000);
+    EXPECT_FALSE(r.active());
+
+    // Monotonic
+    r.start(0, 3300000, 3300, false, 0);
+    int32_t prev = 0;
+    for (uint32_t t = 0; t <= 1000000; t += 1000) {
+        auto v = r.update(t);
+        EXPECT_GE(v, prev);
+        prev = v;
+    }
+    EXPECT_EQ(prev, 3300000);
+}
+
+TEST(Ramp, SCurve)
+{
+    Ramp r;
+    // 1.5 times longer
+    r.start(0, 1000000, 1000, true, 0);
+    EXPECT_EQ(r.duration(), 1500000U);
+
+    EXPECT_EQ(r.update(0), 0);
+    EXPECT_NEAR(r.update(750000), 500000, 64);
+
+    // Peak slope at the midpoint does not exceed the rate
+    auto a = r.update(750000 - 5000);
+    r.start(0, 1000000, 1000, true, 0);
+    auto b = r.update(750000 + 5000);
+    EXPECT_LE(b - a, 10000 + 64);
+
+    // Slow start and end
+    r.start(0, 1000000, 1000, true, 0);
+    EXPECT_LT(r.update(150000), 100000);
+    EXPECT_GT(r.update(1350000), 900000);
+    EXPECT_EQ(r.update(1500000), 1000000);
+    EXPECT_FALSE(r.active());
+}
+
+TEST(Ramp, Edge)
+{
+    Ramp r;
+    // Rate 0 means immediate
+    r.start(0, 1234567, 0, false, 100);
+    EXPECT_EQ(r.duration(), 0U);
+    EXPECT_EQ(r.update(100), 1234567);
+    EXPECT_FALSE(r.active());
+
+    // Same value
+    r.start(5000, 5000, 1000, true, 0);
+    EXPECT_EQ(r.update(0), 5000);
+    EXPECT_FALSE(r.active());
+
+    // Stop keeps the target until restarted
+    r.start(0, 1000000, 1000, false, 0);
+    r.update(100000);
+    r.stop();
+    EXPECT_FALSE(r.active());
+
+    // Wraparound of the clock
+    const uint32_t t0 = 0xFFFFFFFFU - 250000U;
+    r.start(0, 1000000, 1000, false, t0);
+    EXPECT_NEAR(r.update(t0 + 500000U), 500000, 16);
+    EXPECT_TRUE(r.active());
+    EXPECT_EQ(r.update(t0 + 1000000U), 1000000);
+}
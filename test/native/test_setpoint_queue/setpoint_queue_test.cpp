@@ -0,0 +1,179 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for SetpointQueue
+*/
+#include <gtest/gtest.h>
+#include <utility/setpoint_queue.hpp>
+#include <vector>
+#include <utility>
+
+using namespace m5::unit::anadig;
+
+namespace {
+using Output = std::vector<std::pair<uint8_t, uint16_t>>;
+}  // namespace
+
+TEST(SetpointQueue, Basic)
+{
+    SetpointQueue q;
+    Output out;
+    auto output = [&out](const uint8_t ch, const uint16_t code) {
+        out.emplace_back(ch, code);
+        return true;
+    };
+
+    EXPECT_FALSE(q.push(0, 0, 0));  // Not allocated
+    EXPECT_FALSE(q.begin(0));
+    ASSERT_TRUE(q.begin(4, 100));
+    EXPECT_EQ(q.capacity(), 4U);
+    EXPECT_TRUE(q.empty());
+
+    uint32_t at{};
+    EXPECT_FALSE(q.next(at));
+    EXPECT_TRUE(q.push(1000, 0, 10));
+    EXPECT_TRUE(q.push(2000, 0, 20));
+    EXPECT_FALSE(q.push(1500, 0, 15));  // Out of order
+    EXPECT_TRUE(q.push(2000, 1, 21));   // Same time is allowed
+    EXPECT_TRUE(q.push(3000, 0, 30));
+    EXPECT_TRUE(q.full());
+    EXPECT_FALSE(q.push(4000, 0, 40));
+    EXPECT_EQ(q.rejected(), 2U);
+    EXPECT_TRUE(q.next(at));
+    EXPECT_EQ(at, 1000U);
+
+    EXPECT_EQ(q.dispatch(999, output), 0U);
+    EXPECT_TRUE(out.empty());
+    EXPECT_EQ(q.dispatch(1000, output), 1U);
+    EXPECT_EQ(q.dispatch(2050, output), 2U);
+    ASSERT_EQ(out.size(), 3U);
+    EXPECT_EQ(out[0], std::make_pair((uint8_t)0, (uint16_t)10));
+    EXPECT_EQ(out[1], std::make_pair((uint8_t)0, (uint16_t)20));
+    EXPECT_EQ(out[2], std::make_pair((uint8_t)1, (uint16_t)21));
+    EXPECT_EQ(q.size(), 1U);
+
+    EXPECT_EQ(q.dispatch(3200, output), 1U);
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.issued(), 4U);
+    EXPECT_EQ(q.late(), 1U);
+    EXPECT_EQ(q.maxLateness(), 200U);
+    EXPECT_EQ(q.meanLateness(), (0U + 50U + 50U + 200U) / 4U);
+    EXPECT_EQ(q.skipped(), 0U);
+    EXPECT_EQ(q.failed(), 0U);
+
+    q.resetStatistics();
+    EXPECT_EQ(q.issued(), 0U);
+    EXPECT_EQ(q.meanLateness(), 0U);
+}
+
+TEST(SetpointQueue, Skip)
+{
+    SetpointQueue q;
+    Output out;
+    auto output = [&out](const uint8_t ch, const uint16_t code) {
+        out.emplace_back(ch, code);
+        return code != 99;
+    };
+    ASSERT_TRUE(q.begin(8));
+
+    // Late dispatch issues only the latest of each channel
+    EXPECT_TRUE(q.push(100, 0, 1));
+    EXPECT_TRUE(q.push(100, 1, 2));
+    EXPECT_TRUE(q.push(200, 0, 3));
+    EXPECT_TRUE(q.push(300, 0, 4));
+    EXPECT_TRUE(q.push(900, 1, 5));
+    EXPECT_EQ(q.dispatch(500, output), 2U);
+    ASSERT_EQ(out.size(), 2U);
+    EXPECT_EQ(out[0], std::make_pair((uint8_t)1, (uint16_t)2));
+    EXPECT_EQ(out[1], std::make_pair((uint8_t)0, (uint16_t)4));
+    EXPECT_EQ(q.skipped(), 2U);
+    EXPECT_EQ(q.size(), 1U);
+
+    // Failure
+    EXPECT_TRUE(q.push(1000, 0, 99));
+    EXPECT_EQ(q.dispatch(1000, output), 1U);
+    EXPECT_EQ(q.failed(), 1U);
+    EXPECT_EQ(q.issued(), 3U);
+    EXPECT_TRUE(q.empty());
+
+    q.push(2000, 0, 1);
+    q.clear();
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.dispatch(3000, output), 0U);
+}
+
+TEST(SetpointQueue, Wraparound)
+{
+    SetpointQueue q;
+    uint32_t count{};
+    auto output = [&count](const uint8_t, const uint16_t) {
+        ++count;
+        return true;
+    };
+    ASSERT_TRUE(q.begin(3));
+
+    // Ring buffer
+    uint32_t t{};
+    for (uint16_t i = 0; i < 100; ++i) {
+        EXPECT_TRUE(q.push(t, 0, i));
+        t += 10;
+        if (q.full()) {
+            EXPECT_EQ(q.dispatch(t, output), 1U);  // Only the latest
+        }
+    }
+
+    // Clock wraparound
+    q.clear();
+    const uint32_t t0 = 0xFFFFFFFFU - 50U;
+    EXPECT_TRUE(q.push(t0, 0, 1));
+    EXPECT_TRUE(q.push(t0 + 100U, 0, 2));  // Wrapped
+    EXPECT_EQ(q.dispatch(t0 + 10U, output), 1U);
+    EXPECT_EQ(q.dispatch(t0 + 99U, output), 0U);
+    EXPECT_EQ(q.dispatch(t0 + 100U, output), 1U);
+    EXPECT_EQ(q.maxLateness(), 10U);
+}
+
+TEST(SetpointQueue, Commit)
+{
+    SetpointQueue q;
+    Output staged;
+    uint32_t commits{};
+    bool succeed{true};
+    auto stage = [&staged](const uint8_t ch, const uint16_t code) {
+        staged.emplace_back(ch, code);
+        return ch < 2;
+    };
+    auto commit = [&commits, &succeed]() {
+        ++commits;
+        return succeed;
+    };
+    ASSERT_TRUE(q.begin(8));
+
+    // Both channels due at the same time are committed at once
+    EXPECT_TRUE(q.push(100, 0, 1));
+    EXPECT_TRUE(q.push(100, 1, 2));
+    EXPECT_TRUE(q.push(200, 1, 3));
+    EXPECT_EQ(q.dispatch(150, stage, commit), 2U);
+    EXPECT_EQ(commits, 1U);
+    ASSERT_EQ(staged.size(), 2U);
+    EXPECT_EQ(q.issued(), 2U);
+    EXPECT_EQ(q.maxLateness(), 50U);
+
+    // Nothing staged
+    EXPECT_EQ(q.dispatch(150, stage, commit), 0U);
+    EXPECT_EQ(commits, 1U);
+
+    // Failed commit
+    succeed = false;
+    EXPECT_TRUE(q.push(300, 0, 4));
+    EXPECT_TRUE(q.push(300, 2, 5));  // Rejected by stage
+    EXPECT_EQ(q.dispatch(300, stage, commit), 0U);
+    EXPECT_EQ(commits, 2U);
+    EXPECT_EQ(q.failed(), 3U);
+    EXPECT_EQ(q.issued(), 2U);
+    EXPECT_EQ(q.maxLateness(), 50U);
+    EXPECT_TRUE(q.empty());
+}
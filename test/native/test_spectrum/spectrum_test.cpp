@@ -0,0 +1,110 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for spectrum
+*/
+#include <gtest/gtest.h>
+#include <utility/spectrum.hpp>
+#include <vector>
+#include <random>
+#include <cmath>
+
+using namespace m5::unit::anadig;
+
+namespace {
+constexpr double PI{3.14159265358979323846};
+
+// Sine quantized to the ADC code with optional noise
+std::vector<int16_t> tone(const size_t num, const double fs, const double freq, const double amp, const double dc,
+                          const double noise = 0.0, const double harmonic = 0.0)
+{
+    std::mt19937 rng(1);
+    std::normal_distribution<double> nd(0.0, noise > 0.0 ? noise : 1.0);
+    std::vector<int16_t> v(num);
+    for (size_t n = 0; n < num; ++n) {
+        const double t = 2.0 * PI * freq * n / fs;
+        double x       = dc + amp * std::sin(t) + harmonic * std::sin(2.0 * t) + (noise > 0.0 ? nd(rng) : 0.0);
+        x              = (x > 32767.0) ? 32767.0 : (x < -32768.0) ? -32768.0 : x;
+        v[n]           = static_cast<int16_t>(std::lround(x));
+    }
+    return v;
+}
+}  // namespace
+
+TEST(Spectrum, Begin)
+{
+    Spectrum s{};
+    EXPECT_EQ(s.bins(), 0U);
+    EXPECT_FALSE(s.begin(4));
+    EXPECT_FALSE(s.begin(100));
+    EXPECT_FALSE(s.begin(2048));
+    EXPECT_TRUE(s.begin(256));
+    EXPECT_EQ(s.size(), 256U);
+    EXPECT_EQ(s.bins(), 129U);
+
+    const auto v = tone(255, 240.0, 50.0, 1000.0, 0.0);
+    EXPECT_FALSE(s.analyze(v.data(), v.size(), 240.f));  // Not enough samples
+    EXPECT_FALSE(s.analyze(nullptr, 256, 240.f));
+    EXPECT_FALSE(s.analyze(v.data(), v.size(), 0.f));
+}
+
+TEST(Spectrum, Coherent)
+{
+    // Tone on the bin 16 (15 Hz at 240 SPS, N=256)
+    Spectrum s{};
+    EXPECT_TRUE(s.begin(256, Window::Rectangular));
+    const auto v = tone(300, 240.0, 16 * 240.0 / 256, 8000.0, 1234.0);
+    EXPECT_TRUE(s.analyze(v.data(), v.size(), 240.f));
+
+    EXPECT_NEAR(s.magnitude()[16] / 256.0, 8000.0, 8.0);
+    EXPECT_NEAR(s.magnitude()[0] / 256.0, 1234.0, 2.0);
+    EXPECT_LT(s.magnitude()[40] / 256.0, 2.0);
+    EXPECT_FLOAT_EQ(s.frequency(16), 15.f);
+
+    auto& r = s.result();
+    EXPECT_NEAR(r.dominant_hz, 15.f, 0.01f);
+    EXPECT_NEAR(r.dominant / 256.0, 8000.0, 8.0);
+    EXPECT_NEAR(r.dc / 256.0, 1234.0, 2.0);
+}
+
+TEST(Spectrum, Windowed)
+{
+    for (auto&& w : {Window::Hann, Window::BlackmanHarris}) {
+        Spectrum s{};
+        EXPECT_TRUE(s.begin(512, w));
+
+        // Between bins, hum with DC
+        const auto v = tone(512, 240.0, 50.0, 3000.0, -2000.0);
+        EXPECT_TRUE(s.analyze(v.data(), v.size(), 240.f));
+        auto& r = s.result();
+        EXPECT_NEAR(r.dominant_hz, 50.f, 0.1f);
+        EXPECT_NEAR(r.dominant / 256.0, 3000.0, 30.0);
+        EXPECT_NEAR(r.dc / 256.0, -2000.0, 5.0);
+    }
+}
+
+TEST(Spectrum, Enob)
+{
+    Spectrum s{};
+    EXPECT_TRUE(s.begin(1024, Window::BlackmanHarris));
+
+    // Full scale sine quantized to 16 bits: ENOB near 16
+    auto v = tone(1024, 240.0, 37.3, 32000.0, 0.0);
+    EXPECT_TRUE(s.analyze(v.data(), v.size(), 240.f));
+    EXPECT_GT(s.result().enob, 14.0f);
+
+    // Gaussian noise (sigma = 8 codes) : SNR = 20log(32000 / sqrt(2) / 8) = 69 dB
+    v = tone(1024, 240.0, 37.3, 32000.0, 0.0, 8.0);
+    EXPECT_TRUE(s.analyze(v.data(), v.size(), 240.f));
+    EXPECT_NEAR(s.result().snr, 69.0f, 1.5f);
+    EXPECT_NEAR(s.result().enob, (69.0f - 1.76f) / 6.02f, 0.3f);
+
+    // 2nd harmonic at -40 dB is distortion: SNR is kept, SINAD is about 40 dB
+    v = tone(1024, 240.0, 37.3, 32000.0, 0.0, 8.0, 320.0);
+    EXPECT_TRUE(s.analyze(v.data(), v.size(), 240.f));
+    EXPECT_NEAR(s.result().snr, 69.0f, 1.5f);
+    EXPECT_NEAR(s.result().sinad, 40.0f, 0.5f);
+}
@@ -0,0 +1,181 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for StreamEncoder/StreamDecoder
+*/
+#include <gtest/gtest.h>
+#include <utility/stream_codec.hpp>
+#include <vector>
+#include <cstdio>
+#include <cmath>
+
+using namespace m5::unit::anadig;
+
+namespace {
+
+struct Sample {
+    StreamEpoch epoch;
+    int16_t value;
+    uint32_t ms;
+};
+
+StreamEpoch make_epoch(const uint8_t rate, const uint8_t pga)
+{
+    StreamEpoch e{};
+    e.rate    = rate;
+    e.pga     = pga;
+    e.vdd     = 2048.f;
+    e.factor  = 100.f / 610.f;
+    e.lsb_q16 = 123456;
+    return e;
+}
+
+std::vector<uint8_t> encode(const std::vector<Sample>& src, const bool timestamp, const uint16_t block = 64)
+{
+    std::vector<uint8_t> out;
+    StreamEncoder enc([&out](const uint8_t* buf, const size_t len) {
+        out.insert(out.end(), buf, buf + len);
+        return len;
+    }, timestamp, block);
+    EXPECT_TRUE(enc.begin());
+    for (auto&& s : src) {
+        EXPECT_TRUE(enc.push(s.epoch, s.value, s.ms));
+    }
+    EXPECT_TRUE(enc.flush());
+    EXPECT_EQ(enc.samples(), src.size());
+    EXPECT_EQ(enc.bytes(), out.size());
+    return out;
+}
+
+std::vector<Sample> make_samples(const size_t num)
+{
+    std::vector<Sample> v;
+    auto e0 = make_epoch(0, 0);
+    auto e1 = make_epoch(2, 3);
+    for (size_t i = 0; i < num; ++i) {
+        int16_t value = static_cast<int16_t>(std::sin(i * 0.05) * 12000 + (i % 7));
+        v.push_back({(i < num / 2) ? e0 : e1, value, static_cast<uint32_t>(1000 + i * 4 + (i % 3))});
+    }
+    v.push_back({e1, 32767, 0xFFFFFFF0});
+    v.push_back({e1, -32768, 0xFFFFFFFF});
+    return v;
+}
+
+}  // namespace
+
+TEST(StreamCodec, Primitives)
+{
+    using namespace m5::unit::anadig::codec;
+    for (int32_t v : {0, 1, -1, 2, -2, 65535, -65535, INT32_MAX, INT32_MIN}) {
+        EXPECT_EQ(unzigzag(zigzag(v)), v) << v;
+    }
+    EXPECT_EQ(zigzag(0), 0U);
+    EXPECT_EQ(zigzag(-1), 1U);
+    EXPECT_EQ(zigzag(1), 2U);
+
+    uint8_t buf[5]{};
+    EXPECT_EQ(write_varint(buf, 0), 1U);
+    EXPECT_EQ(write_varint(buf, 127), 1U);
+    EXPECT_EQ(write_varint(buf, 128), 2U);
+    EXPECT_EQ(buf[0], 0x80);
+    EXPECT_EQ(buf[1], 0x01);
+    EXPECT_EQ(write_varint(buf, 0xFFFFFFFF), 5U);
+}
+
+TEST(StreamCodec, RoundTrip)
+{
+    const auto src = make_samples(1000);
+
+    for (bool timestamp : {false, true}) {
+        for (uint16_t block : {1, 7, 64, 1024}) {
+            SCOPED_TRACE(timestamp);
+            SCOPED_TRACE(block);
+            auto bin = encode(src, timestamp, block);
+
+            std::vector<Sample> dst;
+            StreamDecoder dec([&dst](const StreamEpoch& e, const int16_t v, const uint32_t ms) {
+                dst.push_back({e, v, ms});
+            });
+            EXPECT_TRUE(dec.feed(bin.data(), bin.size()));
+            EXPECT_FALSE(dec.error());
+            EXPECT_EQ(dec.hasTimestamp(), timestamp);
+            EXPECT_EQ(dec.samples(), src.size());
+
+            ASSERT_EQ(dst.size(), src.size());
+            for (size_t i = 0; i < src.size(); ++i) {
+                EXPECT_EQ(dst[i].epoch, src[i].epoch) << i;
+                EXPECT_EQ(dst[i].value, src[i].value) << i;
+                EXPECT_EQ(dst[i].ms, timestamp ? src[i].ms : 0U) << i;
+            }
+        }
+    }
+}
+
+TEST(StreamCodec, SplitFeed)
+{
+    const auto src = make_samples(200);
+    auto bin       = encode(src, true, 16);
+
+    // Feed one byte at a time
+    std::vector<Sample> dst;
+    StreamDecoder dec([&dst](const StreamEpoch& e, const int16_t v, const uint32_t ms) { dst.push_back({e, v, ms}); });
+    for (auto&& b : bin) {
+        EXPECT_TRUE(dec.feed(&b, 1));
+    }
+    ASSERT_EQ(dst.size(), src.size());
+    for (size_t i = 0; i < src.size(); ++i) {
+        EXPECT_EQ(dst[i].value, src[i].value) << i;
+        EXPECT_EQ(dst[i].ms, src[i].ms) << i;
+    }
+}
+
+TEST(StreamCodec, Size)
+{
+    const auto src = make_samples(1000);
+    auto bin       = encode(src, false);
+
+    // Compared with the text format of the example
+    size_t text{};
+    char tmp[64]{};
+    for (auto&& s : src) {
+        text += snprintf(tmp, sizeof(tmp), ">Raw:%d\n>Voltage(mV):%.2f\n", s.value, s.value * 0.0625f);
+    }
+    EXPECT_LT(bin.size() * 5, text);
+}
+
+TEST(StreamCodec, Broken)
+{
+    const auto src = make_samples(10);
+    auto bin       = encode(src, false);
+
+    uint32_t cnt{};
+    StreamDecoder dec([&cnt](const StreamEpoch&, const int16_t, const uint32_t) { ++cnt; });
+
+    // Wrong magic
+    bin[3] = 0x02;
+    EXPECT_FALSE(dec.feed(bin.data(), bin.size()));
+    EXPECT_TRUE(dec.error());
+    EXPECT_EQ(cnt, 0U);
+
+    // Unknown tag
+    bin[3] = 0x01;
+    bin[4] = 0x55;
+    dec.reset();
+    EXPECT_FALSE(dec.feed(bin.data(), bin.size()));
+    EXPECT_EQ(cnt, 0U);
+
+    // Recover
+    bin[4] = codec::TAG_EPOCH;
+    dec.reset();
+    EXPECT_TRUE(dec.feed(bin.data(), bin.size()));
+    EXPECT_EQ(cnt, src.size());
+
+    // Sink failure
+    StreamEncoder enc([](const uint8_t*, const size_t) -> size_t { return 0; });
+    EXPECT_FALSE(enc.begin());
+    StreamEncoder none(nullptr);
+    EXPECT_FALSE(none.begin());
+}
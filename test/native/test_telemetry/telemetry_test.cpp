@@ -0,0 +1,190 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for TelemetryWriter/TelemetryReader
+*/
+#include <gtest/gtest.h>
+#include <utility/telemetry.hpp>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstring>
+
+using namespace m5::unit::anadig;
+using namespace m5::unit::anadig::telemetry;
+
+namespace {
+
+struct Sink {
+    std::vector<uint8_t> data;
+    uint32_t calls{};
+    TelemetryWriter::sink_t get()
+    {
+        return [this](const uint8_t* buf, const size_t len) {
+            data.insert(data.end(), buf, buf + len);
+            ++calls;
+            return len;
+        };
+    }
+};
+
+}  // namespace
+
+TEST(Telemetry, COBS)
+{
+    std::mt19937 rng(1);
+    for (size_t len : {0, 1, 2, 10, 253, 254, 255, 600}) {
+        std::vector<uint8_t> src(len), enc(cobs_max_size(len)), dec(enc.size());
+        for (auto&& v : src) {
+            v = (rng() % 4) ? rng() & 0xFF : 0;
+        }
+        auto elen = cobs_encode(enc.data(), src.data(), len);
+        EXPECT_LE(elen, cobs_max_size(len));
+        for (size_t i = 0; i < elen; ++i) {
+            EXPECT_NE(enc[i], 0) << len << ":" << i;
+        }
+        auto dlen = cobs_decode(dec.data(), enc.data(), elen);
+        ASSERT_EQ(dlen, len);
+        EXPECT_TRUE(std::equal(src.begin(), src.end(), dec.begin()));
+        // In place
+        EXPECT_EQ(cobs_decode(enc.data(), enc.data(), elen), len);
+        EXPECT_TRUE(std::equal(src.begin(), src.end(), enc.begin()));
+    }
+
+    const uint8_t src[] = {0x11, 0x22, 0x00, 0x33};
+    const uint8_t expected[] = {0x03, 0x11, 0x22, 0x02, 0x33};
+    uint8_t enc[8]{};
+    EXPECT_EQ(cobs_encode(enc, src, sizeof(src)), sizeof(expected));
+    EXPECT_EQ(std::memcmp(enc, expected, sizeof(expected)), 0);
+
+    const uint8_t broken[] = {0x05, 0x11, 0x22};
+    EXPECT_EQ(cobs_decode(enc, broken, sizeof(broken)), 0U);
+}
+
+TEST(Telemetry, CRC)
+{
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    EXPECT_EQ(crc16(check, sizeof(check)), 0x29B1);
+}
+
+TEST(Telemetry, RoundTrip)
+{
+    Sink sink;
+    TelemetryWriter writer(sink.get());
+
+    std::vector<TelemetryRecord> src;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        TelemetryRecord r{};
+        r.kind    = (i & 1) ? Kind::DacCode : Kind::AdcRaw;
+        r.source  = i % 3;
+        r.channel = i % 2;
+        r.ms      = 0xFFFFFF00 + i * 4;  // Wrap around
+        r.value   = (i & 1) ? (int32_t)(i * 4) & 0x0FFF : (int16_t)(i * 97);
+        src.push_back(r);
+        EXPECT_TRUE(writer.push(r.kind, r.source, r.channel, r.value, r.ms));
+    }
+    EXPECT_TRUE(writer.push(Kind::User, 255, 15, INT32_MIN, 0));
+    src.push_back({Kind::User, 255, 15, 0, INT32_MIN, 0});
+    EXPECT_TRUE(writer.flush());
+    EXPECT_TRUE(writer.flush());  // Nothing to do
+
+    EXPECT_EQ(writer.records(), src.size());
+    EXPECT_EQ(writer.frames(), sink.calls);  // Single write per frame
+    EXPECT_GT(writer.frames(), 1U);
+    EXPECT_EQ(writer.bytes(), sink.data.size());
+    EXPECT_EQ(writer.failed(), 0U);
+
+    std::vector<TelemetryRecord> dst;
+    TelemetryReader reader([&dst](const TelemetryRecord& r) { dst.push_back(r); });
+    // Split feeding
+    for (size_t i = 0; i < sink.data.size(); i += 7) {
+        reader.feed(sink.data.data() + i, std::min<size_t>(7, sink.data.size() - i));
+    }
+    EXPECT_EQ(reader.frames(), writer.frames());
+    EXPECT_EQ(reader.lost(), 0U);
+    EXPECT_EQ(reader.crcErrors(), 0U);
+    EXPECT_EQ(reader.frameErrors(), 0U);
+
+    ASSERT_EQ(dst.size(), src.size());
+    for (size_t i = 0; i < src.size(); ++i) {
+        EXPECT_EQ(dst[i].kind, src[i].kind) << i;
+        EXPECT_EQ(dst[i].source, src[i].source) << i;
+        EXPECT_EQ(dst[i].channel, src[i].channel) << i;
+        EXPECT_EQ(dst[i].ms, src[i].ms) << i;
+        EXPECT_EQ(dst[i].value, src[i].value) << i;
+    }
+}
+
+TEST(Telemetry, Latency)
+{
+    Sink sink;
+    TelemetryWriter writer(sink.get(), 10);
+
+    EXPECT_TRUE(writer.pushAdc(0, 1, 100));
+    EXPECT_TRUE(writer.update(109));
+    EXPECT_EQ(sink.calls, 0U);
+    EXPECT_TRUE(writer.update(110));
+    EXPECT_EQ(sink.calls, 1U);
+
+    EXPECT_TRUE(writer.pushAdc(0, 1, 200));
+    EXPECT_TRUE(writer.pushDac(1, 2, 205));
+    EXPECT_EQ(sink.calls, 1U);
+    EXPECT_TRUE(writer.pushDac(1, 3, 210));  // Exceeded on push
+    EXPECT_EQ(sink.calls, 2U);
+    EXPECT_EQ(writer.records(), 4U);
+}
+
+TEST(Telemetry, Errors)
+{
+    Sink sink;
+    TelemetryWriter writer(sink.get());
+    std::vector<std::vector<uint8_t>> frames;
+    for (int f = 0; f < 5; ++f) {
+        sink.data.clear();
+        for (int i = 0; i < 4; ++i) {
+            writer.pushAdc(0, f * 10 + i, f * 100 + i);
+        }
+        writer.flush();
+        frames.push_back(sink.data);
+    }
+
+    uint32_t cnt{};
+    TelemetryReader reader([&cnt](const TelemetryRecord&) { ++cnt; });
+
+    // Garbage before the first frame
+    const uint8_t garbage[] = {0x12, 0x34, 0x56, 0x00};
+    reader.feed(garbage, sizeof(garbage));
+    EXPECT_EQ(reader.frameErrors(), 1U);
+
+    reader.feed(frames[0].data(), frames[0].size());
+    // Corrupted
+    auto bad = frames[1];
+    bad[4] ^= 0x01;
+    reader.feed(bad.data(), bad.size());
+    EXPECT_EQ(reader.crcErrors(), 1U);
+    // frames[2] dropped
+    reader.feed(frames[3].data(), frames[3].size());
+    reader.feed(frames[4].data(), frames[4].size());
+
+    EXPECT_EQ(reader.frames(), 3U);
+    EXPECT_EQ(reader.lost(), 2U);
+    EXPECT_EQ(cnt, 12U);
+
+    // Too long
+    std::vector<uint8_t> big(MAX_FRAME * 2, 0x01);
+    big.push_back(0x00);
+    reader.feed(big.data(), big.size());
+    EXPECT_EQ(reader.frameErrors(), 2U);
+
+    reader.reset();
+    EXPECT_EQ(reader.frames(), 0U);
+
+    // Sink failure
+    TelemetryWriter fail([](const uint8_t*, const size_t) -> size_t { return 0; });
+    EXPECT_TRUE(fail.pushAdc(0, 0, 0));
+    EXPECT_FALSE(fail.flush());
+    EXPECT_EQ(fail.failed(), 1U);
+}
@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for transfer
+*/
+#include <gtest/gtest.h>
+#include <utility/transfer.hpp>
+#include <cmath>
+#include <limits>
+
+using namespace m5::unit::anadig;
+
+TEST(Transfer, Table)
+{
+    TransferTable table{};
+    EXPECT_FALSE(table.valid());
+    EXPECT_TRUE(std::isnan(table.convert(0)));
+
+    EXPECT_FALSE(table.build(100, 100, 16, [](const int16_t c) { return (float)c; }));
+    EXPECT_FALSE(table.build(0, 100, 0, [](const int16_t c) { return (float)c; }));
+    EXPECT_FALSE(table.build(0, 100, 16, nullptr));
+    EXPECT_FALSE(table.build(-32768, 32767, 4096, [](const int16_t c) { return (float)c; }));  // Too many entries
+
+    // Linear function is exact with interpolation
+    EXPECT_TRUE(table.build(-32768, 32767, 256, [](const int16_t c) { return c * 0.5f + 10.0f; }));
+    EXPECT_EQ(table.step(), 256U);
+    EXPECT_EQ(table.size(), 257U);
+    for (int32_t c = -32768; c <= 32767; c += 97) {
+        EXPECT_FLOAT_EQ(table.convert(c), c * 0.5f + 10.0f) << c;
+    }
+    EXPECT_FLOAT_EQ(table.convert(32767), 32767 * 0.5f + 10.0f);
+
+    // Clamped to the range
+    EXPECT_TRUE(table.build(-2048, 2047, 100, [](const int16_t c) { return (float)c; }));
+    EXPECT_EQ(table.step(), 64U);
+    EXPECT_EQ(table.size(), 65U);
+    EXPECT_FLOAT_EQ(table.convert(-32768), -2048.f);
+    EXPECT_FLOAT_EQ(table.convert(32767), 2047.f);
+    EXPECT_FLOAT_EQ(table.convert(2047), 2047.f);
+
+    // Nearest entry
+    EXPECT_TRUE(table.build(0, 1024, 16, [](const int16_t c) { return (float)c; }, false));
+    EXPECT_EQ(table.step(), 64U);
+    EXPECT_FLOAT_EQ(table.convert(31), 0.f);
+    EXPECT_FLOAT_EQ(table.convert(32), 64.f);
+    EXPECT_FLOAT_EQ(table.convert(1000), 1024.f);
+
+    // Nonlinear function within the interpolation error
+    EXPECT_TRUE(table.build(0, 32767, 512, [](const int16_t c) { return std::sqrt((float)c); }));
+    for (int32_t c = 1024; c <= 32767; c += 111) {
+        EXPECT_NEAR(table.convert(c), std::sqrt((float)c), 0.01f) << c;
+    }
+
+    table.clear();
+    EXPECT_FALSE(table.valid());
+}
+
+TEST(Transfer, Stock)
+{
+    // 10k NTC B=3950 with 10k series from 3.3V
+    auto ntc = ntc_beta(3300.f, 10000.f, 10000.f, 25.f, 3950.f);
+    EXPECT_NEAR(ntc(1650.f), 25.f, 1e-3f);
+    // R(0C) = 10k * exp(3950 * (1/273.15 - 1/298.15)) = 33.6k
+    const float r0c = 10000.f * std::exp(3950.f * (1.f / 273.15f - 1.f / 298.15f));
+    EXPECT_NEAR(ntc(3300.f * r0c / (10000.f + r0c)), 0.f, 1e-2f);
+    EXPECT_TRUE(std::isnan(ntc(0.f)));
+    EXPECT_TRUE(std::isnan(ntc(3300.f)));
+
+    // 250 ohm shunt, 0 - 10 bar
+    auto loop = current_loop(250.f, 0.f, 10.f);
+    EXPECT_FLOAT_EQ(loop(1000.f), 0.f);
+    EXPECT_FLOAT_EQ(loop(3000.f), 5.f);
+    EXPECT_FLOAT_EQ(loop(5000.f), 10.f);
+    EXPECT_TRUE(std::isnan(loop(0.f)));     // Open loop
+    EXPECT_TRUE(std::isnan(loop(5500.f)));  // Short
+
+    // 2 mV/V load cell with 5V excitation, 50 kg
+    auto cell = bridge(5000.f, 2.f, 50.f, 0.1f);
+    EXPECT_FLOAT_EQ(cell(0.1f), 0.f);
+    EXPECT_NEAR(cell(10.1f), 50.f, 1e-4f);
+    EXPECT_NEAR(cell(5.1f), 25.f, 1e-4f);
+
+    // NTC table from the code of ADC (62.5 uV/LSB)
+    TransferTable table{};
+    EXPECT_TRUE(table.build(0, 32767, 512, [&ntc](const int16_t c) { return ntc(c * 0.0625f * 1.6f); }));
+    for (int32_t c = 2000; c <= 30000; c += 997) {
+        EXPECT_NEAR(table.convert(c), ntc(c * 0.0625f * 1.6f), 0.05f) << c;
+    }
+}
+
+TEST(Transfer, FaultEdge)
+{
+    // UnitADS1110 (62.5 uV/LSB, 100k/610k divider), 250 ohm shunt, 0 - 10 bar
+    // A step of 256 codes is 97.6 mV (0.39 mA), 3.6 mA (900 mV) is the code 2361
+    auto loop  = current_loop(250.f, 0.f, 10.f);
+    auto to_mv = [](const int32_t c) { return c * 0.0625f * 6.1f; };
+    TransferTable table{};
+    EXPECT_TRUE(table.build(-32768, 32767, 256, [&](const int16_t c) { return loop(to_mv(c)); }));
+    EXPECT_EQ(table.step(), 256U);
+    for (int32_t c = 2048; c <= 3072; ++c) {
+        const float expected = loop(to_mv(c));
+        if (std::isnan(expected)) {
+            EXPECT_TRUE(std::isnan(table.convert(c))) << c;
+        } else {
+            EXPECT_NEAR(table.convert(c), expected, 1e-4f) << c;
+        }
+    }
+    EXPECT_TRUE(std::isnan(table.convert(2360)));
+    EXPECT_NEAR(table.convert(2361), -0.2497f, 1e-3f);  // 3.6005 mA
+    // Upper edge (21 mA)
+    for (int32_t c = 13568; c <= 14080; ++c) {
+        const float expected = loop(to_mv(c));
+        EXPECT_EQ(std::isnan(table.convert(c)), std::isnan(expected)) << c;
+        if (!std::isnan(expected)) {
+            EXPECT_NEAR(table.convert(c), expected, 1e-4f) << c;
+        }
+    }
+    EXPECT_TRUE(std::isnan(table.convert(-32768)));
+    EXPECT_TRUE(std::isnan(table.convert(32767)));
+
+    // Nearest entry falls back to the edge value
+    EXPECT_TRUE(table.build(-32768, 32767, 256, [&](const int16_t c) { return loop(to_mv(c)); }, false));
+    EXPECT_TRUE(std::isnan(table.convert(2360)));
+    EXPECT_FLOAT_EQ(table.convert(2361), loop(to_mv(2361)));
+    EXPECT_FLOAT_EQ(table.convert(2500), loop(to_mv(2560)));
+
+    // Valid only at the maximum code
+    EXPECT_TRUE(table.build(0, 1000, 4, [](const int16_t c) {
+        return (c >= 900) ? (float)c : std::numeric_limits<float>::quiet_NaN();
+    }));
+    EXPECT_TRUE(std::isnan(table.convert(899)));
+    EXPECT_FLOAT_EQ(table.convert(900), 900.f);
+    EXPECT_FLOAT_EQ(table.convert(950), 950.f);
+    EXPECT_FLOAT_EQ(table.convert(1000), 1000.f);
+}
@@ -0,0 +1,109 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  UnitTest for WaveformGenerator
+*/
+#include <gtest/gtest.h>
+#include <utility/waveform.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace m5::unit::anadig;
+
+namespace {
+// Like UnitGP8413 10V range
+constexpr CodeScale scale10V(0x7FFF, 10000 * 1000U, 10000 * 1000U);
+}  // namespace
+
+TEST(Waveform, Build)
+{
+    WaveformGenerator gen;
+    EXPECT_FALSE(gen.valid());
+    EXPECT_EQ(gen.size(), 0U);
+    EXPECT_EQ(gen.next(), 0U);
+
+    EXPECT_FALSE(gen.build(Waveform::Sine, 0, scale10V, 5000000, 5000000));
+    EXPECT_FALSE(gen.build(Waveform::Sine, WaveformGenerator::MAX_BITS + 1, scale10V, 5000000, 5000000));
+    EXPECT_FALSE(gen.build(WaveformGenerator::shape_function_t{}, 8, scale10V, 5000000, 5000000));
+    EXPECT_FALSE(gen.build(nullptr, 8));
+
+    // Sine 0-10V
+    EXPECT_TRUE(gen.build(Waveform::Sine, 8, scale10V, 5000000, 5000000));
+    EXPECT_TRUE(gen.valid());
+    ASSERT_EQ(gen.size(), 256U);
+    auto t = gen.table();
+    for (size_t i = 0; i < gen.size(); ++i) {
+        float mv = 5000.f + 5000.f * std::sin(2.0 * M_PI * i / 256);
+        EXPECT_NEAR(t[i], dac_voltage_to_code(mv, 10000.f, 10000.f, 0x7FFF), 1) << i;
+    }
+    EXPECT_EQ(*std::max_element(t, t + 256), 0x7FFF);
+    EXPECT_EQ(*std::min_element(t, t + 256), 0);
+
+    // Clamped
+    EXPECT_TRUE(gen.build(Waveform::Square, 4, scale10V, 20000000, 0));
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(gen.table()[i], 0x7FFF);
+        EXPECT_EQ(gen.table()[i + 8], 0);
+    }
+
+    // Sawtooth, Triangle
+    EXPECT_TRUE(gen.build(Waveform::Sawtooth, 2, scale10V, 4000000, 5000000));
+    EXPECT_EQ(gen.table()[0], scale10V.to_code(1000000));
+    EXPECT_EQ(gen.table()[2], scale10V.to_code(5000000));
+    EXPECT_TRUE(gen.build(Waveform::Triangle, 3, scale10V, 4000000, 5000000));
+    const int32_t tri[] = {5000000, 7000000, 9000000, 7000000, 5000000, 3000000, 1000000, 3000000};
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(gen.table()[i], scale10V.to_code(tri[i])) << i;
+    }
+
+    // Arbitrary
+    EXPECT_TRUE(gen.build([](const float ph) { return ph < 0.25f ? 1.0f : 0.0f; }, 4, scale10V, 1000000, 0));
+    EXPECT_EQ(gen.table()[3], scale10V.to_code(1000000));
+    EXPECT_EQ(gen.table()[4], 0);
+    // Voltage to code function (e.g. microvoltage_to_raw with the correction)
+    auto shifted = [](const int32_t uv) { return static_cast<uint16_t>(scale10V.to_code(uv) + 1); };
+    EXPECT_TRUE(gen.build(Waveform::Triangle, 3, shifted, 4000000, 5000000));
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(gen.table()[i], scale10V.to_code(tri[i]) + 1) << i;
+    }
+    EXPECT_FALSE(gen.build(Waveform::Triangle, 3, WaveformGenerator::code_function_t{}, 4000000, 5000000));
+
+    const uint16_t codes[4] = {1, 2, 3, 4};
+    EXPECT_TRUE(gen.build(codes, 2));
+    EXPECT_TRUE(std::equal(codes, codes + 4, gen.table()));
+}
+
+TEST(Waveform, Stepping)
+{
+    WaveformGenerator gen;
+    const uint16_t codes[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    ASSERT_TRUE(gen.build(codes, 3));
+
+    // 1 period per 16 updates
+    gen.setFrequency(100.0f, 1600.0f);
+    EXPECT_EQ(gen.tuningWord(), 1U << 28);
+    for (uint32_t i = 0; i < 64; ++i) {
+        EXPECT_EQ(gen.current(), (i / 2) % 8) << i;
+        EXPECT_EQ(gen.next(), (i / 2) % 8) << i;
+    }
+    EXPECT_EQ(gen.phase(), 0U);
+
+    gen.setPhase(0x80000000U);
+    EXPECT_EQ(gen.next(), 4U);
+
+    // Clock driven
+    for (uint32_t us = 625; us < 100000; us += 1250) {
+        EXPECT_EQ(gen.at(us), (us / 1250) % 8) << us;
+    }
+    // Wrap around of the elapsed time
+    gen.setFrequency(1000.0f, 0.0f);
+    EXPECT_EQ(gen.tuningWord(), 0U);
+    EXPECT_EQ(gen.at(0xFFFFFFFFU - 124), gen.at(0xFFFFFFFFU - 124 - 1000000));
+
+    EXPECT_EQ(WaveformGenerator::tuning_word(1.0f, 0.0f), 0U);
+    EXPECT_EQ(WaveformGenerator::tuning_word(1000.0f, 1000.0f), UINT32_MAX);
+    EXPECT_EQ(WaveformGenerator::tuning_word(1.0f, 4.0f), 0x40000000U);
+}
@@ -0,0 +1,120 @@
+/*
+ * SPDX-FileCopyrightText: 2025 M5Stack Technology CO LTD
+ *
+ * SPDX-License-Identifier: MIT
+ */
+/*
+  Decoder CLI of the telemetry frames (utility/telemetry.hpp) for Linux
+
+  Build:
+    g++ -std=c++11 -O2 -I../../src -o telemetry_decode telemetry_decode.cpp \
+        ../../src/utility/telemetry.cpp ../../src/utility/stream_codec.cpp
+  Usage:
+    telemetry_decode [-s] [file|device]  (stdin if omitted)
+    e.g. stty -F /dev/ttyACM0 raw -echo && telemetry_decode /dev/ttyACM0 > log.csv
+  Output:
+    CSV (seq,ms,kind,source,channel,value) to stdout, statistics to stderr
+    -s: Statistics only
+*/
+#include <utility/telemetry.hpp>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+
+using namespace m5::unit::anadig;
+
+namespace {
+
+volatile std::sig_atomic_t stop_requested{};
+
+void on_signal(int)
+{
+    stop_requested = 1;
+}
+
+const char* kind_name(const telemetry::Kind k)
+{
+    switch (k) {
+        case telemetry::Kind::AdcRaw:
+            return "adc_raw";
+        case telemetry::Kind::AdcMicroVoltage:
+            return "adc_uv";
+        case telemetry::Kind::DacCode:
+            return "dac_code";
+        case telemetry::Kind::DacMicroVoltage:
+            return "dac_uv";
+        case telemetry::Kind::User:
+            return "user";
+        default:
+            return "unknown";
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    bool stats_only{};
+    const char* path{};
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-s") == 0) {
+            stats_only = true;
+        } else if (std::strcmp(argv[i], "-h") == 0) {
+            std::fprintf(stderr, "Usage: %s [-s] [file|device]\n", argv[0]);
+            return 0;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    // read(2) returns what has arrived, so a tty is decoded without waiting for a full buffer
+    const int fd = path ? ::open(path, O_RDONLY) : STDIN_FILENO;
+    if (fd < 0) {
+        std::perror(path);
+        return 1;
+    }
+    // Without SA_RESTART so that a blocked read is interrupted by the signal
+    struct sigaction sa {};
+    sa.sa_handler = on_signal;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = 0;
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+
+    TelemetryReader reader([stats_only](const TelemetryRecord& r) {
+        if (!stats_only) {
+            std::printf("%u,%u,%s,%u,%u,%d\n", r.seq, r.ms, kind_name(r.kind), r.source, r.channel, r.value);
+        }
+    });
+
+    if (!stats_only) {
+        std::printf("seq,ms,kind,source,channel,value\n");
+    }
+    uint8_t buf[4096]{};
+    while (!stop_requested) {
+        const ssize_t len = ::read(fd, buf, sizeof(buf));
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::perror("read");
+            break;
+        }
+        if (len == 0) {
+            break;
+        }
+        reader.feed(buf, static_cast<size_t>(len));
+        std::fflush(stdout);
+    }
+    if (fd != STDIN_FILENO) {
+        ::close(fd);
+    }
+
+    std::fprintf(stderr, "frames:%u records:%u lost:%u crc_errors:%u frame_errors:%u\n", reader.frames(),
+                 reader.records(), reader.lost(), reader.crcErrors(), reader.frameErrors());
+    return (reader.crcErrors() || reader.frameErrors()) ? 2 : 0;
+}